@@ -25,10 +25,7 @@
 #include <gtkmm.h>
 #include <memory>
 #include "config.h"
-#include "pipe_manager.hpp"
-#include "presets_manager.hpp"
-#include "stream_input_effects.hpp"
-#include "stream_output_effects.hpp"
+#include "core.hpp"
 
 class Application : public Gtk::Application {
  public:
@@ -41,13 +38,8 @@ class Application : public Gtk::Application {
 
   static auto create() -> Glib::RefPtr<Application>;
   Glib::RefPtr<Gio::Settings> settings;
-  Glib::RefPtr<Gio::Settings> soe_settings;
-  Glib::RefPtr<Gio::Settings> sie_settings;
 
-  std::unique_ptr<PipeManager> pm;
-  std::unique_ptr<StreamOutputEffects> soe;
-  std::unique_ptr<StreamInputEffects> sie;
-  std::unique_ptr<PresetsManager> presets_manager;
+  std::unique_ptr<Core> core;
 
  protected:
   auto on_command_line(const Glib::RefPtr<Gio::ApplicationCommandLine>& command_line) -> int override;
@@ -63,7 +55,6 @@ class Application : public Gtk::Application {
   bool running_as_service = false;
 
   void create_actions();
-  void update_bypass_state(const Glib::ustring& key);
 };
 
 #endif
@@ -21,7 +21,11 @@
 #define AUTOGAIN_HPP
 
 #include <ebur128.h>
+#include <array>
+#include <atomic>
+#include <thread>
 #include "plugin_base.hpp"
+#include "ring_buffer.hpp"
 
 class AutoGain : public PluginBase {
  public:
@@ -52,18 +56,48 @@ class AutoGain : public PluginBase {
       results;  // range
 
  private:
-  bool ebur128_ready = false;
+  uint ebur_rate = 0U;
 
-  uint old_rate = 0U;
+  std::atomic<uint> worker_rate = 0U;  // copy of the rate set in setup() for the worker
 
-  double target = -23.0;  // target loudness level
-  double internal_output_gain = 1.0;
+  static constexpr float control_period = 0.1F;  // seconds
+
+  static constexpr float gain_time_constant = 0.3F;  // seconds
+
+  std::atomic<double> target = -23.0;  // target loudness level
+
+  /*
+    The loudness is measured by the worker thread at a fixed control rate. The realtime thread only writes the
+    interleaved samples to the ring buffer and ramps its gain towards the last value computed by the worker.
+  */
+
+  RingBuffer ring;
+
+  std::jthread worker;
+
+  std::atomic<bool> reset_history = false;
+
+  std::atomic<float> target_gain = 1.0F;
+
+  float gain = 1.0F;
+  float gain_smoothing = 1.0F;
+  std::atomic<float> gain_value = 1.0F;  // the gain shown in the interface
+
+  // the last measurement. The realtime thread sends it to the main thread
+
+  std::atomic<double> loudness = 0.0, momentary = 0.0, shortterm = 0.0, global = 0.0, relative = 0.0, range = 0.0;
 
   std::vector<float> data;
 
   ebur128_state* ebur_state = nullptr;
 
   void init_ebur128();
+
+  void run_worker(const std::stop_token& stoken);
+
+  void update_gain();
+
+  void emit_meters() override;
 };
 
 #endif
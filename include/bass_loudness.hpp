@@ -44,6 +44,8 @@ class BassLoudness : public PluginBase {
 
  private:
   std::unique_ptr<lv2::Lv2Wrapper> lv2_wrapper;
+
+  auto set_realtime_parameter(const std::string& key, const Glib::VariantBase& value) -> bool override;
 };
 
 #endif
@@ -46,10 +46,10 @@ class Compressor : public PluginBase {
 
   sigc::signal<void(const float&)> reduction, sidechain, curve, envelope, latency;
 
-  float reduction_port_value = 0.0F;
-  float sidechain_port_value = 0.0F;
-  float curve_port_value = 0.0F;
-  float envelope_port_value = 0.0F;
+  std::atomic<float> reduction_port_value = 0.0F;
+  std::atomic<float> sidechain_port_value = 0.0F;
+  std::atomic<float> curve_port_value = 0.0F;
+  std::atomic<float> envelope_port_value = 0.0F;
   float latency_port_value = 0.0F;
 
  private:
@@ -58,6 +58,10 @@ class Compressor : public PluginBase {
   std::unique_ptr<lv2::Lv2Wrapper> lv2_wrapper;
 
   std::vector<pw_proxy*> list_proxies;
+
+  void emit_meters() override;
+
+  auto set_realtime_parameter(const std::string& key, const Glib::VariantBase& value) -> bool override;
 };
 
 #endif
@@ -0,0 +1,110 @@
+/*
+ *  Copyright © 2017-2022 Wellington Wallace
+ *
+ *  This file is part of EasyEffects.
+ *
+ *  EasyEffects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  EasyEffects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with EasyEffects.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef CONTROL_INTERFACE_HPP
+#define CONTROL_INTERFACE_HPP
+
+#include <giomm.h>
+#include <set>
+#include <tuple>
+#include "stream_input_effects.hpp"
+#include "stream_output_effects.hpp"
+
+/*
+  D-Bus interface for external automation of the plugin parameters. The pipeline argument is "output" or "input", the
+  plugin argument is the plugin name and the key is the name of the parameter in the plugin GSettings schema. Clients
+  subscribe to the ParameterChanged signal to follow the changes. It is sent at most once per signals_interval for
+  each parameter and it has the value the parameter has when it is sent.
+*/
+
+class ControlInterface {
+ public:
+  ControlInterface(const Glib::RefPtr<Gio::DBus::Connection>& connection,
+                   StreamOutputEffects* soe,
+                   StreamInputEffects* sie);
+  ControlInterface(const ControlInterface&) = delete;
+  auto operator=(const ControlInterface&) -> ControlInterface& = delete;
+  ControlInterface(const ControlInterface&&) = delete;
+  auto operator=(const ControlInterface&&) -> ControlInterface& = delete;
+  ~ControlInterface();
+
+  inline static const std::string object_path = "/com/github/wwmm/easyeffects/Control";
+
+  inline static const std::string interface_name = "com.github.wwmm.easyeffects.Control";
+
+ private:
+  inline static const std::string log_tag = "control_interface: ";
+
+  inline static const std::string introspection_xml =
+      "<node>"
+      "  <interface name='com.github.wwmm.easyeffects.Control'>"
+      "    <method name='SetParameter'>"
+      "      <arg type='s' name='pipeline' direction='in'/>"
+      "      <arg type='s' name='plugin' direction='in'/>"
+      "      <arg type='s' name='key' direction='in'/>"
+      "      <arg type='v' name='value' direction='in'/>"
+      "    </method>"
+      "    <method name='GetParameter'>"
+      "      <arg type='s' name='pipeline' direction='in'/>"
+      "      <arg type='s' name='plugin' direction='in'/>"
+      "      <arg type='s' name='key' direction='in'/>"
+      "      <arg type='v' name='value' direction='out'/>"
+      "    </method>"
+      "    <signal name='ParameterChanged'>"
+      "      <arg type='s' name='pipeline'/>"
+      "      <arg type='s' name='plugin'/>"
+      "      <arg type='s' name='key'/>"
+      "      <arg type='v' name='value'/>"
+      "    </signal>"
+      "  </interface>"
+      "</node>";
+
+  Glib::RefPtr<Gio::DBus::Connection> connection;
+
+  StreamOutputEffects* soe = nullptr;
+  StreamInputEffects* sie = nullptr;
+
+  guint registration_id = 0U;
+
+  Gio::DBus::InterfaceVTable interface_vtable;
+
+  std::vector<sigc::connection> connections;
+
+  static constexpr uint signals_interval = 50U;  // milliseconds
+
+  sigc::connection signals_timeout;
+
+  std::set<std::tuple<std::string, std::string, std::string>> changed_parameters;  // pipeline, plugin and key
+
+  void emit_changed_parameters();
+
+  auto find_plugin(const std::string& pipeline, const std::string& plugin) -> std::shared_ptr<PluginBase>;
+
+  void connect_plugins(const std::string& pipeline, EffectsBase* effects_base);
+
+  void on_method_call(const Glib::RefPtr<Gio::DBus::Connection>& connection,
+                      const Glib::ustring& sender,
+                      const Glib::ustring& object_path,
+                      const Glib::ustring& interface_name,
+                      const Glib::ustring& method_name,
+                      const Glib::VariantContainerBase& parameters,
+                      const Glib::RefPtr<Gio::DBus::MethodInvocation>& invocation);
+};
+
+#endif
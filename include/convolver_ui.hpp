@@ -23,9 +23,13 @@
 #include <fftw3.h>
 #include <glibmm.h>
 #include <glibmm/i18n.h>
+#include <condition_variable>
 #include <filesystem>
+#include <map>
 #include <mutex>
 #include <numbers>
+#include <optional>
+#include <thread>
 #include <sndfile.hh>
 #include "plot.hpp"
 #include "plugin_ui_base.hpp"
@@ -72,6 +76,41 @@ class ConvolverUi : public Gtk::Box, public PluginUiBase {
 
   Gtk::Popover* popover_menu = nullptr;
 
+  /*
+    Everything we need to plot an impulse file. The waveform is kept as a min/max pyramid: level n holds the extrema of
+    consecutive blocks of 2^n samples. This way decimating it to the plot resolution does not depend on the file size.
+  */
+
+  struct IrsInfo {
+    int rate = 0;
+
+    int frames = 0;
+
+    float duration = 0.0F;
+
+    std::filesystem::file_time_type mtime;
+
+    std::vector<std::vector<float>> left_min, left_max, right_min, right_max;
+
+    std::vector<float> left_power, right_power;
+  };
+
+  /*
+    The fftw planner is not thread safe. The plan is created in the main thread and only executed in the worker.
+  */
+
+  struct IrsJob {
+    std::string path;
+
+    int frames = 0;
+
+    fftwf_plan plan = nullptr;
+
+    float* real_input = nullptr;
+
+    fftwf_complex* complex_output = nullptr;
+  };
+
   std::filesystem::path irs_dir;
 
   Glib::RefPtr<Gio::FileMonitor> folder_monitor;
@@ -79,6 +118,10 @@ class ConvolverUi : public Gtk::Box, public PluginUiBase {
   std::vector<float> left_mag, right_mag, time_axis;
   std::vector<float> left_spectrum, right_spectrum, freq_axis;
 
+  std::shared_ptr<const IrsInfo> irs_info;
+
+  std::map<std::string, std::shared_ptr<const IrsInfo>> irs_info_cache;
+
   Glib::RefPtr<Gtk::StringList> string_list;
 
   std::unique_ptr<Plot> plot;
@@ -89,6 +132,12 @@ class ConvolverUi : public Gtk::Box, public PluginUiBase {
 
   std::mutex lock_guard_irs_info;
 
+  std::condition_variable_any irs_job_cv;
+
+  std::optional<IrsJob> irs_job;
+
+  std::jthread irs_worker;
+
   void setup_listview();
 
   auto get_irs_names() -> std::vector<Glib::ustring>;
@@ -101,7 +150,23 @@ class ConvolverUi : public Gtk::Box, public PluginUiBase {
 
   void get_irs_info();
 
-  void get_irs_spectrum(const int& rate);
+  void run_irs_worker(const std::stop_token& stoken);
+
+  auto load_irs_info(const IrsJob& job, const std::stop_token& stoken) -> std::shared_ptr<IrsInfo>;
+
+  void show_irs_info(const std::string& path, const std::shared_ptr<const IrsInfo>& info);
+
+  void show_irs_failure();
+
+  static void destroy_irs_job(const IrsJob& job);
+
+  static void build_minmax_pyramid(const std::vector<float>& samples,
+                                   std::vector<std::vector<float>>& min,
+                                   std::vector<std::vector<float>>& max);
+
+  void decimate_waveform(const int& n_points);
+
+  void bin_spectrum(const int& n_points);
 
   void plot_waveform();
 
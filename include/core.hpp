@@ -0,0 +1,81 @@
+/*
+ *  Copyright © 2017-2022 Wellington Wallace
+ *
+ *  This file is part of EasyEffects.
+ *
+ *  EasyEffects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  EasyEffects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with EasyEffects.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef CORE_HPP
+#define CORE_HPP
+
+#include <giomm.h>
+#include <memory>
+#include "control_interface.hpp"
+#include "pipe_manager.hpp"
+#include "presets_manager.hpp"
+#include "stream_input_effects.hpp"
+#include "stream_output_effects.hpp"
+
+/*
+  Everything EasyEffects needs to process audio: the PipeWire manager, both effects pipelines and the presets manager
+  together with the device autoloading and the global bypass. It depends only on GLib/Gio so it can be used by the
+  graphical application and by the headless daemon.
+*/
+
+class Core {
+ public:
+  Core();
+  Core(const Core&) = delete;
+  auto operator=(const Core&) -> Core& = delete;
+  Core(const Core&&) = delete;
+  auto operator=(const Core&&) -> Core& = delete;
+  ~Core();
+
+  Glib::RefPtr<Gio::Settings> settings;
+  Glib::RefPtr<Gio::Settings> soe_settings;
+  Glib::RefPtr<Gio::Settings> sie_settings;
+
+  std::unique_ptr<PipeManager> pm;
+  std::unique_ptr<StreamOutputEffects> soe;
+  std::unique_ptr<StreamInputEffects> sie;
+  std::unique_ptr<PresetsManager> presets_manager;
+
+  std::unique_ptr<ControlInterface> control_interface;
+
+  // loads the input and the output presets with this name if they exist
+
+  void load_preset(const std::string& name);
+
+  // exports the control interface of the plugin parameters on the D-Bus connection of the application
+
+  void export_control_interface(const Glib::RefPtr<Gio::DBus::Connection>& connection);
+
+  /*
+    Only one process at a time can run the core. Otherwise the graphical application and the daemon would both create
+    the EasyEffects virtual devices. The process that owns this name on the session bus wins. The bus releases it when
+    the process exits. Returns false if another process already owns it.
+  */
+
+  static auto claim_bus_name(const Glib::RefPtr<Gio::DBus::Connection>& connection) -> bool;
+
+ private:
+  inline static const std::string log_tag = "core: ";
+
+  inline static const std::string bus_name = "com.github.wwmm.easyeffects.Core";
+
+  void update_bypass_state(const Glib::ustring& key);
+};
+
+#endif
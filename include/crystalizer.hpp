@@ -21,9 +21,7 @@
 #define CRYSTALIZER_HPP
 
 #include <deque>
-#include "fir_filter_bandpass.hpp"
-#include "fir_filter_highpass.hpp"
-#include "fir_filter_lowpass.hpp"
+#include "fir_filter_bank.hpp"
 #include "plugin_base.hpp"
 
 class Crystalizer : public PluginBase {
@@ -53,7 +51,6 @@ class Crystalizer : public PluginBase {
   bool n_samples_is_power_of_2 = true;
   bool filters_are_ready = false;
   bool notify_latency = false;
-  bool do_first_rotation = true;
 
   uint blocksize = 512U;
   uint latency_n_frames = 0U;
@@ -68,18 +65,17 @@ class Crystalizer : public PluginBase {
 
   std::array<float, nbands + 1U> frequencies;
   std::array<float, nbands> band_intensity;
-  std::array<float, nbands> band_last_L;
-  std::array<float, nbands> band_last_R;
-  std::array<float, nbands> band_next_L;
-  std::array<float, nbands> band_next_R;
+
+  // the last two samples of each band in the previous block
+
+  std::array<std::array<float, 2U>, nbands> band_history_L;
+  std::array<std::array<float, 2U>, nbands> band_history_R;
 
   std::array<std::vector<float>, nbands> band_data_L;
   std::array<std::vector<float>, nbands> band_data_R;
   std::array<std::vector<float>, nbands> band_gain;
-  std::array<std::vector<float>, nbands> band_second_derivative_L;
-  std::array<std::vector<float>, nbands> band_second_derivative_R;
 
-  std::array<std::unique_ptr<FirFilterBase>, nbands> filters;
+  std::unique_ptr<FirFilterBank> filter_bank;
 
   std::deque<float> deque_out_L, deque_out_R;
 
@@ -87,127 +83,70 @@ class Crystalizer : public PluginBase {
 
   template <typename T1>
   void enhance_peaks(T1& data_left, T1& data_right) {
-    for (uint n = 0U; n < nbands; n++) {
-      std::copy(data_left.begin(), data_left.end(), band_data_L.at(n).begin());
-      std::copy(data_right.begin(), data_right.end(), band_data_R.at(n).begin());
+    // all the bands are calculated from a single forward fft of each channel
+
+    filter_bank->process(data_left, data_right, band_data_L, band_data_R);
 
-      filters.at(n)->process(band_data_L.at(n), band_data_R.at(n));
+    std::ranges::fill(data_left, 0.0F);
+    std::ranges::fill(data_right, 0.0F);
 
-      /*
-        Later we will need to calculate the second derivative of each band. This
-        is done through the central difference method. In order to calculate
-        the derivative at the last elements of the array we have to know the first
-        element of the next buffer. As we do not have this information the only
-        way to do this calculation is delaying the signal by 1 sample.
-      */
+    for (uint n = 0U; n < nbands; n++) {
+      if (!band_mute[n]) {
+        const float intensity = (band_bypass[n]) ? 0.0F : band_intensity[n];
 
-      // last (R,L) becomes the first
+        add_enhanced_band(band_data_L[n], band_history_L[n], intensity, data_left);
+        add_enhanced_band(band_data_R[n], band_history_R[n], intensity, data_right);
+      }
 
-      std::rotate(band_data_L.at(n).rbegin(), band_data_L.at(n).rbegin() + 1, band_data_L.at(n).rend());
-      std::rotate(band_data_R.at(n).rbegin(), band_data_R.at(n).rbegin() + 1, band_data_R.at(n).rend());
+      // the history is updated even for muted bands. Otherwise unmuting them would cause a discontinuity
 
-      if (do_first_rotation) {
-        /*
-          band_data was rotated. Its first values are the last ones from the original array. we have to save them for
-          the next round.
-        */
+      update_band_history(band_data_L[n], band_history_L[n]);
+      update_band_history(band_data_R[n], band_history_R[n]);
+    }
+  }
 
-        band_next_L.at(n) = band_data_L.at(n)[0];
-        band_next_R.at(n) = band_data_R.at(n)[0];
+  /*
+    Peak enhancing through the second derivative. The derivative is calculated through the central difference method.
+    In order to calculate it at the last sample of the block we would need the first sample of the next one. As we do
+    not have it the output is delayed by 1 sample:
 
-        band_last_L.at(n) = 0.0F;
-        band_last_R.at(n) = 0.0F;
+    y[m] = x[m - 1] - intensity * (x[m] - 2 * x[m - 1] + x[m - 2])
 
-        band_data_L.at(n)[0] = 0.0F;
-        band_data_R.at(n)[0] = 0.0F;
+    This is a 3 taps stencil. The first two samples need the history of the previous block and are handled separately.
+    The remaining ones are computed in a branch free loop over contiguous memory that the compiler vectorizes. The
+    result is accumulated directly in the output so the bands are summed in the same pass.
+  */
 
-        do_first_rotation = false;
-      } else {
-        /*
-          band_data was rotated. Its first values are the last ones from the original array. we have to save them for
-          the next round.
-        */
+  template <typename T1>
+  void add_enhanced_band(const std::vector<float>& band,
+                         const std::array<float, 2U>& history,
+                         const float& intensity,
+                         T1& output) {
+    const float c0 = -intensity;
+    const float c1 = 1.0F + 2.0F * intensity;
+    const float c2 = -intensity;
 
-        const float L = band_data_L.at(n)[0];
-        const float R = band_data_R.at(n)[0];
+    const float* x = band.data();
+    float* y = output.data();
 
-        band_data_L.at(n)[0] = band_next_L.at(n);
-        band_data_R.at(n)[0] = band_next_R.at(n);
+    y[0] += c0 * x[0] + c1 * history[1] + c2 * history[0];
 
-        band_next_L.at(n) = L;
-        band_next_R.at(n) = R;
-      }
+    if (blocksize > 1U) {
+      y[1] += c0 * x[1] + c1 * x[0] + c2 * history[1];
     }
 
-    for (uint n = 0U; n < nbands; n++) {
-      // Calculating the second derivative
-
-      if (!band_bypass.at(n)) {
-        for (uint m = 0U; m < blocksize; m++) {
-          const float L = band_data_L.at(n)[m];
-          const float R = band_data_R.at(n)[m];
-
-          if (m > 0 && m < blocksize - 1) {
-            const float& L_lower = band_data_L.at(n)[m - 1U];
-            const float& R_lower = band_data_R.at(n)[m - 1U];
-            const float& L_upper = band_data_L.at(n)[m + 1U];
-            const float& R_upper = band_data_R.at(n)[m + 1U];
-
-            band_second_derivative_L.at(n)[m] = L_upper - 2.0F * L + L_lower;
-            band_second_derivative_R.at(n)[m] = R_upper - 2.0F * R + R_lower;
-          } else if (m == 0U) {
-            const float& L_lower = band_last_L.at(n);
-            const float& R_lower = band_last_R.at(n);
-            const float& L_upper = band_data_L.at(n)[m + 1];
-            const float& R_upper = band_data_R.at(n)[m + 1];
-
-            band_second_derivative_L.at(n)[m] = L_upper - 2.0F * L + L_lower;
-            band_second_derivative_R.at(n)[m] = R_upper - 2.0F * R + R_lower;
-          } else if (m == blocksize - 1) {
-            const float& L_upper = band_next_L.at(n);
-            const float& R_upper = band_next_R.at(n);
-            const float& L_lower = band_data_L.at(n)[m - 1U];
-            const float& R_lower = band_data_R.at(n)[m - 1U];
-
-            band_second_derivative_L.at(n)[m] = L_upper - 2.0F * L + L_lower;
-            band_second_derivative_R.at(n)[m] = R_upper - 2.0F * R + R_lower;
-          }
-        }
-
-        // peak enhancing using second derivative
-
-        for (uint m = 0U; m < blocksize; m++) {
-          const float L = band_data_L.at(n)[m];
-          const float R = band_data_R.at(n)[m];
-          const float& d2L = band_second_derivative_L.at(n)[m];
-          const float& d2R = band_second_derivative_R.at(n)[m];
-
-          band_data_L.at(n)[m] = L - band_intensity.at(n) * d2L;
-          band_data_R.at(n)[m] = R - band_intensity.at(n) * d2R;
-
-          if (m == blocksize - 1U) {
-            band_last_L.at(n) = L;
-            band_last_R.at(n) = R;
-          }
-        }
-      } else {
-        band_last_L.at(n) = band_data_L.at(n)[blocksize - 1];
-        band_last_R.at(n) = band_data_R.at(n)[blocksize - 1];
-      }
+    for (uint m = 2U; m < blocksize; m++) {
+      y[m] += c0 * x[m] + c1 * x[m - 1U] + c2 * x[m - 2U];
     }
+  }
 
-    // add bands
-
-    for (uint m = 0U; m < blocksize; m++) {
-      data_left[m] = 0.0F;
-      data_right[m] = 0.0F;
-
-      for (uint n = 0; n < nbands; n++) {
-        if (!band_mute.at(n)) {
-          data_left[m] += band_data_L.at(n)[m];
-          data_right[m] += band_data_R.at(n)[m];
-        }
-      }
+  void update_band_history(const std::vector<float>& band, std::array<float, 2U>& history) const {
+    if (blocksize > 1U) {
+      history[0] = band[blocksize - 2U];
+      history[1] = band[blocksize - 1U];
+    } else {
+      history[0] = history[1];
+      history[1] = band[0];
     }
   }
 };
@@ -41,11 +41,15 @@ class Deesser : public PluginBase {
 
   sigc::signal<void(const double&)> compression, detected;
 
-  double compression_port_value = 0.0;
-  double detected_port_value = 0.0;
+  std::atomic<double> compression_port_value = 0.0;
+  std::atomic<double> detected_port_value = 0.0;
 
  private:
   std::unique_ptr<lv2::Lv2Wrapper> lv2_wrapper;
+
+  void emit_meters() override;
+
+  auto set_realtime_parameter(const std::string& key, const Glib::VariantBase& value) -> bool override;
 };
 
 #endif
@@ -47,6 +47,8 @@ class Delay : public PluginBase {
   uint latency_n_frames = 0U;
 
   std::unique_ptr<lv2::Lv2Wrapper> lv2_wrapper;
+
+  auto set_realtime_parameter(const std::string& key, const Glib::VariantBase& value) -> bool override;
 };
 
 #endif
@@ -0,0 +1,112 @@
+/*
+ *  Copyright © 2017-2022 Wellington Wallace
+ *
+ *  This file is part of EasyEffects.
+ *
+ *  EasyEffects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  EasyEffects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with EasyEffects.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef DELAY_ESTIMATOR_HPP
+#define DELAY_ESTIMATOR_HPP
+
+#include <fftw3.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <span>
+#include <thread>
+#include <vector>
+#include "util.hpp"
+
+/*
+  Estimates how many frames the microphone signal lags behind the reference signal using the generalized cross
+  correlation with phase transform (GCC-PHAT) https://en.wikipedia.org/wiki/Generalized_cross-correlation
+  The realtime thread only copies samples to a capture window. When the window is complete it is handed to a worker
+  thread that does the ffts. A new window is captured while the previous one is analyzed.
+*/
+
+class DelayEstimator {
+ public:
+  DelayEstimator(std::string tag);
+  DelayEstimator(const DelayEstimator&) = delete;
+  auto operator=(const DelayEstimator&) -> DelayEstimator& = delete;
+  DelayEstimator(const DelayEstimator&&) = delete;
+  auto operator=(const DelayEstimator&&) -> DelayEstimator& = delete;
+  ~DelayEstimator();
+
+  void set_rate(const uint& value);
+
+  // largest delay that can be detected in seconds
+
+  void set_max_delay(const float& value);
+
+  // it creates fftw plans. It has to be called from the same thread that destroys this object
+
+  void setup();
+
+  [[nodiscard]] auto is_ready() const -> bool;
+
+  // it has to be called from the realtime thread. Stereo inputs are analyzed as mono
+
+  void process(std::span<const float> mic_left,
+               std::span<const float> mic_right,
+               std::span<const float> reference_left,
+               std::span<const float> reference_right);
+
+  // the last reliable estimate in frames or -1 if there is none yet
+
+  [[nodiscard]] auto get_delay() const -> int;
+
+ private:
+  const std::string log_tag;
+
+  bool ready = false;
+
+  uint rate = 0U;
+  uint max_delay_frames = 0U;
+  uint window_size = 0U;
+  uint fft_size = 0U;
+  uint n_bins = 0U;
+  uint capture_position = 0U;
+
+  float max_delay = 0.5F;  // seconds
+
+  std::atomic<int> delay = -1;
+
+  // the realtime thread writes to the capture buffers and the worker reads the analysis buffers
+
+  std::vector<float> mic_capture, reference_capture;
+  std::vector<float> mic_analysis, reference_analysis;
+
+  std::atomic<bool> window_pending = false;
+
+  std::jthread worker;
+
+  float *mic_time = nullptr, *reference_time = nullptr;
+
+  fftwf_complex *mic_freq = nullptr, *reference_freq = nullptr;
+
+  fftwf_plan forward_plan = nullptr;
+  fftwf_plan backward_plan = nullptr;
+
+  void free_fftw();
+
+  void stop_worker();
+
+  void run_worker(const std::stop_token& stoken);
+
+  auto estimate() -> int;
+};
+
+#endif
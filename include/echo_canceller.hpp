@@ -21,7 +21,9 @@
 #define ECHO_CANCELLER_HPP
 
 #include <speex/speex_echo.h>
+#include <speex/speex_preprocess.h>
 #include <deque>
+#include "delay_estimator.hpp"
 #include "plugin_base.hpp"
 
 class EchoCanceller : public PluginBase {
@@ -47,30 +49,85 @@ class EchoCanceller : public PluginBase {
 
   sigc::signal<void(const float&)> latency;
 
+  sigc::signal<void(const float&)> reference_delay;  // ms
+
  private:
+  /*
+    In the mono microphone mode a single microphone channel is cancelled against both channels of the probe. This is
+    the common headset case where the stereo playback reaches a mono microphone.
+  */
+
+  enum class ChannelMode { stereo, mono_microphone };
+
+  ChannelMode channel_mode = ChannelMode::stereo;
+
   bool notify_latency = false;
   bool ready = false;
+  bool automatic_delay = false;
+  bool estimator_ready = false;
+  bool enable_suppression = false;
+  bool enable_agc = false;
+  bool enable_dereverb = false;
+  bool preprocessor_active = false;
 
   uint blocksize = 512U;
   uint blocksize_ms = 20U;
   uint filter_length_ms = 100U;
   uint latency_n_frames = 0U;
+  uint n_mic_channels = 2U;
+  uint block_position = 0U;
+  uint probe_delay = 0U;
+  uint probe_delay_position = 0U;
+
+  int estimated_delay = -1;
+  int residual_echo_suppression = -40;  // dB
+  int noise_suppression = -15;          // dB
+
+  static constexpr float max_reference_delay = 0.5F;  // seconds
+
+  // the probe is delayed a little less than the estimate so the start of the echo path stays inside the filter
+
+  static constexpr float delay_safety_margin = 0.005F;  // seconds
 
   const float inv_short_max = 1.0F / (SHRT_MAX + 1);
 
-  std::vector<spx_int16_t> data_L;
-  std::vector<spx_int16_t> data_R;
-  std::vector<spx_int16_t> probe_L;
-  std::vector<spx_int16_t> probe_R;
-  std::vector<spx_int16_t> filtered_L;
-  std::vector<spx_int16_t> filtered_R;
+  // interleaved blocks. They are allocated in init_speex and filled by index in the realtime thread
+
+  std::vector<spx_int16_t> data;
+  std::vector<spx_int16_t> probe;
+  std::vector<spx_int16_t> filtered;
+
+  std::vector<float> probe_delay_L, probe_delay_R;
 
   std::deque<float> deque_out_L, deque_out_R;
 
-  SpeexEchoState* echo_state_L = nullptr;
-  SpeexEchoState* echo_state_R = nullptr;
+  std::unique_ptr<DelayEstimator> delay_estimator;
+
+  // a single multichannel state adapts the filters of all microphone and probe channel pairs together
+
+  SpeexEchoState* echo_state = nullptr;
+
+  /*
+    Optional preprocessor stage run on the output of the echo canceller in the same block loop. There is one state per
+    microphone channel. In mono microphone mode it is bound to the echo state so it can remove the residual echo
+    together with the noise.
+  */
+
+  std::vector<SpeexPreprocessState*> preprocess_states;
+
+  std::vector<spx_int16_t> preprocess_block;
+
+  void update_channel_mode();
+
+  void update_probe_delay();
 
   void init_speex();
+
+  void init_preprocessor();
+
+  void free_preprocessor();
+
+  void update_preprocessor();
 };
 
 #endif
@@ -38,8 +38,18 @@ class EchoCancellerUi : public Gtk::Box, public PluginUiBase {
 
   void reset() override;
 
+  void on_new_reference_delay(const float& value);
+
  private:
-  Gtk::SpinButton *frame_size = nullptr, *filter_length = nullptr;
+  Gtk::SpinButton *frame_size = nullptr, *filter_length = nullptr, *residual_echo_suppression = nullptr,
+                  *noise_suppression = nullptr;
+
+  Gtk::ComboBoxText* channel_mode = nullptr;
+
+  Gtk::ToggleButton *automatic_delay = nullptr, *enable_suppression = nullptr, *enable_agc = nullptr,
+                    *enable_dereverb = nullptr;
+
+  Gtk::Label* reference_delay = nullptr;
 };
 
 #endif
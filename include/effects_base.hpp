@@ -21,6 +21,7 @@
 #define EFFECTS_BASE_HPP
 
 #include <giomm.h>
+#include <functional>
 #include "autogain.hpp"
 #include "bass_enhancer.hpp"
 #include "bass_loudness.hpp"
@@ -90,6 +91,16 @@ class EffectsBase {
 
   auto get_pipeline_latency() -> float;
 
+  [[nodiscard]] auto get_plugins_map() const -> const std::map<std::string, std::shared_ptr<PluginBase>>&;
+
+  /*
+    Fades the pipeline output to silence, calls apply and fades it back in. When the transition time is zero apply is
+    called right away. A call made while a transition is pending replaces its apply, so only the latest preset is
+    loaded and it is always loaded in silence.
+  */
+
+  void run_preset_transition(const std::function<void()>& apply);
+
   sigc::signal<void(const float&)> pipeline_latency;
 
  protected:
@@ -101,6 +112,8 @@ class EffectsBase {
 
   std::vector<pw_proxy*> list_proxies, list_proxies_listen_mic;
 
+  sigc::connection transition_timeout;
+
   void activate_filters();
 
   void deactivate_filters();
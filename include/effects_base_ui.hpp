@@ -166,7 +166,25 @@ class EffectsBaseUi {
 
   std::map<uint, bool> enabled_app_list;
 
-  void add_plugins_to_stack_plugins();
+  guint meters_tick_id = 0U;
+
+  // the plugin pages are created when they are shown and destroyed after being hidden for this amount of seconds
+
+  static constexpr uint hidden_page_timeout = 60U;
+
+  std::string last_visible_plugin;
+
+  std::map<std::string, sigc::connection> page_timeouts;
+
+  void on_visible_plugin_changed();
+
+  void remove_unselected_plugin_pages();
+
+  void show_plugin_page(const std::string& name);
+
+  void remove_hidden_plugin_page(const std::string& name);
+
+  auto add_plugin_page(const std::string& name) -> Gtk::Widget*;
 
   void setup_listview_players();
 
@@ -54,6 +54,8 @@ class Equalizer : public PluginBase {
 
   std::unique_ptr<lv2::Lv2Wrapper> lv2_wrapper;
 
+  auto set_realtime_parameter(const std::string& key, const Glib::VariantBase& value) -> bool override;
+
   const uint max_bands = 32U;
 
   uint latency_n_frames = 0U;
@@ -41,10 +41,14 @@ class Exciter : public PluginBase {
 
   sigc::signal<void(const double&)> harmonics;
 
-  double harmonics_port_value = 0.0;
+  std::atomic<double> harmonics_port_value = 0.0;
 
  private:
   std::unique_ptr<lv2::Lv2Wrapper> lv2_wrapper;
+
+  void emit_meters() override;
+
+  auto set_realtime_parameter(const std::string& key, const Glib::VariantBase& value) -> bool override;
 };
 
 #endif
@@ -32,6 +32,11 @@ class FirFilterBandpass : public FirFilterBase {
   ~FirFilterBandpass() override;
 
   void setup() override;
+
+  static auto create_bandpass_kernel(const uint& rate,
+                                     const float& min_frequency,
+                                     const float& max_frequency,
+                                     const float& transition_band) -> std::vector<float>;
 };
 
 #endif
@@ -0,0 +1,126 @@
+/*
+ *  Copyright © 2017-2022 Wellington Wallace
+ *
+ *  This file is part of EasyEffects.
+ *
+ *  EasyEffects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  EasyEffects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with EasyEffects.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef FIR_FILTER_BANK_HPP
+#define FIR_FILTER_BANK_HPP
+
+#include <fftw3.h>
+#include <algorithm>
+#include <array>
+#include <span>
+#include "fir_filter_bandpass.hpp"
+#include "util.hpp"
+
+/*
+  Splits a stereo signal into a set of adjacent bandpass bands. All bands share the same analysis stage: each block is
+  transformed only once per channel and its spectrum is multiplied by the spectrum of each band kernel. This is a
+  uniformly partitioned overlap-save convolution https://en.wikipedia.org/wiki/Overlap%E2%80%93save_method
+  The kernels are split in partitions of n_samples so there is no extra latency besides the kernel group delay.
+*/
+
+class FirFilterBank {
+ public:
+  FirFilterBank(std::string tag);
+  FirFilterBank(const FirFilterBank&) = delete;
+  auto operator=(const FirFilterBank&) -> FirFilterBank& = delete;
+  FirFilterBank(const FirFilterBank&&) = delete;
+  auto operator=(const FirFilterBank&&) -> FirFilterBank& = delete;
+  ~FirFilterBank();
+
+  void set_rate(const uint& value);
+
+  void set_n_samples(const uint& value);
+
+  void set_transition_band(const float& value);
+
+  // the n bands are delimited by n + 1 frequencies
+
+  void set_frequencies(std::span<const float> value);
+
+  // it creates fftw plans. It has to be called from the same thread that destroys this object
+
+  void setup();
+
+  [[nodiscard]] auto is_ready() const -> bool;
+
+  [[nodiscard]] auto get_delay() const -> float;
+
+  /*
+    Filters one block of n_samples. bands_left and bands_right must have one buffer of n_samples per band.
+  */
+
+  void process(std::span<const float> data_left,
+               std::span<const float> data_right,
+               std::span<std::vector<float>> bands_left,
+               std::span<std::vector<float>> bands_right);
+
+ private:
+  const std::string log_tag;
+
+  bool ready = false;
+
+  uint n_samples = 0U;
+  uint rate = 0U;
+  uint fft_size = 0U;
+  uint n_bins = 0U;
+  uint n_partitions = 0U;
+
+  float transition_band = 100.0F;  // Hz
+  float delay = 0.0F;
+
+  std::vector<float> frequencies;
+
+  /*
+    The spectra are stored with real and imaginary parts in separated arrays. This way the complex multiply-accumulate
+    loops are easily vectorized by the compiler.
+  */
+
+  struct Spectra {
+    std::vector<float> re, im;
+  };
+
+  // kernel_spectra[band] holds n_partitions spectra of n_bins
+
+  std::vector<Spectra> kernel_spectra;
+
+  struct Channel {
+    uint fdl_position = 0U;
+
+    std::vector<float> input;  // the last two blocks
+
+    Spectra fdl;  // frequency domain delay line with the spectra of the last n_partitions blocks
+  };
+
+  std::array<Channel, 2U> channels;
+
+  Spectra accumulator;
+
+  float* fft_time = nullptr;
+
+  fftwf_complex* fft_freq = nullptr;
+
+  fftwf_plan forward_plan = nullptr;
+  fftwf_plan backward_plan = nullptr;
+
+  void free_fftw();
+
+  void process_channel(Channel& channel, std::span<const float> data, std::span<std::vector<float>> bands);
+};
+
+#endif
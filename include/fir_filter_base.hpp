@@ -50,6 +50,9 @@ class FirFilterBase {
 
   [[nodiscard]] auto get_delay() const -> float;
 
+  static auto create_lowpass_kernel(const uint& rate, const float& cutoff, const float& transition_band)
+      -> std::vector<float>;
+
   template <typename T1>
   void process(T1& data_left, T1& data_right) {
     std::span conv_left_in{conv->inpdata(0), conv->inpdata(0) + n_samples};
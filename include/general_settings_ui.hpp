@@ -26,6 +26,7 @@
 #include <gtkmm.h>
 #include <filesystem>
 #include "application.hpp"
+#include "spinbutton_helper.hpp"
 #include "util.hpp"
 
 class GeneralSettingsUi : public Gtk::Box {
@@ -49,6 +50,8 @@ class GeneralSettingsUi : public Gtk::Box {
   Gtk::Switch *enable_autostart = nullptr, *process_all_inputs = nullptr, *process_all_outputs = nullptr,
               *theme_switch = nullptr, *shutdown_on_window_close = nullptr;
 
+  Gtk::SpinButton* preset_transition_time = nullptr;
+
   Gtk::Button *reset_settings = nullptr, *about_button = nullptr;
 
   std::vector<sigc::connection> connections;
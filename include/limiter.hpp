@@ -41,16 +41,20 @@ class Limiter : public PluginBase {
 
   sigc::signal<void(const float&)> gain_left, gain_right, sidechain_left, sidechain_right, latency;
 
-  float gain_l_port_value = 0.0F;
-  float gain_r_port_value = 0.0F;
-  float sidechain_l_port_value = 0.0F;
-  float sidechain_r_port_value = 0.0F;
+  std::atomic<float> gain_l_port_value = 0.0F;
+  std::atomic<float> gain_r_port_value = 0.0F;
+  std::atomic<float> sidechain_l_port_value = 0.0F;
+  std::atomic<float> sidechain_r_port_value = 0.0F;
   float latency_port_value = 0.0F;
 
  private:
   uint latency_n_frames = 0U;
 
   std::unique_ptr<lv2::Lv2Wrapper> lv2_wrapper;
+
+  void emit_meters() override;
+
+  auto set_realtime_parameter(const std::string& key, const Glib::VariantBase& value) -> bool override;
 };
 
 #endif
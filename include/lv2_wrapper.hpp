@@ -30,6 +30,9 @@
 #include <lv2/options/options.h>
 #include <lv2/parameters/parameters.h>
 #include <array>
+#include <atomic>
+#include <functional>
+#include <mutex>
 #include <span>
 #include <unordered_map>
 #include "util.hpp"
@@ -49,11 +52,21 @@ struct Port {
 
   float value;  // Control value (if applicable)
 
+  float next_value;  // Control value set by the main thread. It is copied to value by run()
+
   bool is_input;  // True if an input port
 
   bool optional;  // True if the connection is optional
 };
 
+struct KeyBinding {
+  GSettings* settings;  // The settings object of the key
+
+  std::string lv2_symbol;
+
+  std::function<float(const Glib::VariantBase&)> to_port_value;  // Converts the GSettings value to the port value
+};
+
 class Lv2Wrapper {
  public:
   Lv2Wrapper(const std::string& plugin_uri);
@@ -85,7 +98,7 @@ class Lv2Wrapper {
 
   void activate();
 
-  void run() const;
+  void run();
 
   void deactivate();
 
@@ -115,6 +128,16 @@ class Lv2Wrapper {
                     const Glib::ustring& gsettings_key,
                     const std::string& lv2_symbol);
 
+  /*
+    Sets the control ports bound to the key without going through GSettings. The value must have the type of the key.
+    It returns false when there is no port bound to it. The enums are not handled here because GSettings stores their
+    nicks.
+  */
+
+  auto set_bound_key(const Glib::RefPtr<Gio::Settings>& settings,
+                     const std::string& gsettings_key,
+                     const Glib::VariantBase& value) -> bool;
+
  private:
   inline static const std::string log_tag = "lv2_wrapper: ";
 
@@ -134,6 +157,42 @@ class Lv2Wrapper {
 
   std::vector<Port> ports;
 
+  std::unordered_map<std::string, uint> control_port_indices;  // control port symbol -> index in ports
+
+  std::unordered_map<std::string, std::vector<KeyBinding>> key_bindings;  // gsettings key -> bound ports
+
+  /*
+    The control values are written by the main thread to next_value and copied to the ports by run() before a block is
+    processed. While GSettings is emitting the changes of a transaction, like a preset load, the copy is skipped. This
+    way a block is never processed with only part of the new values. The realtime thread only tries to lock
+    control_mutex. It never waits for it.
+  */
+
+  std::mutex control_mutex;
+
+  std::atomic<bool> control_values_pending = false;
+
+  uint transaction_depth = 0U;
+
+  std::vector<std::pair<Glib::RefPtr<Gio::Settings>, std::array<gulong, 2U>>> change_event_handlers;
+
+  void add_key_binding(const Glib::RefPtr<Gio::Settings>& settings,
+                       const Glib::ustring& gsettings_key,
+                       const std::string& lv2_symbol,
+                       const std::function<float(const Glib::VariantBase&)>& to_port_value);
+
+  void watch_transactions(const Glib::RefPtr<Gio::Settings>& settings);
+
+  static auto on_change_event_begin(GSettings* settings, gpointer keys, gint n_keys, Lv2Wrapper* self) -> gboolean;
+
+  static auto on_change_event_end(GSettings* settings, gpointer keys, gint n_keys, Lv2Wrapper* self) -> gboolean;
+
+  void begin_transaction();
+
+  void end_transaction();
+
+  void update_control_ports();
+
   std::unordered_map<std::string, LV2_URID> map_uri_to_urid;
   std::unordered_map<LV2_URID, std::string> map_urid_to_uri;
 
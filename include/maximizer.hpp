@@ -46,7 +46,7 @@ class Maximizer : public PluginBase {
 
   sigc::signal<void(const float&)> latency;
 
-  double reduction_port_value = 0.0;
+  std::atomic<double> reduction_port_value = 0.0;
 
   float latency_port_value = 0.0F;
 
@@ -54,6 +54,10 @@ class Maximizer : public PluginBase {
   uint latency_n_frames = 0U;
 
   std::unique_ptr<lv2::Lv2Wrapper> lv2_wrapper;
+
+  void emit_meters() override;
+
+  auto set_realtime_parameter(const std::string& key, const Glib::VariantBase& value) -> bool override;
 };
 
 #endif
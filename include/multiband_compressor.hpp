@@ -50,15 +50,19 @@ class MultibandCompressor : public PluginBase {
 
   float latency_port_value = 0.0F;
 
-  std::array<float, n_bands> frequency_range_end_port_array = {0.0F, 0.0F, 0.0F, 0.0F, 0.0F, 0.0F, 0.0F, 0.0F};
-  std::array<float, n_bands> envelope_port_array = {0.0F, 0.0F, 0.0F, 0.0F, 0.0F, 0.0F, 0.0F, 0.0F};
-  std::array<float, n_bands> curve_port_array = {0.0F, 0.0F, 0.0F, 0.0F, 0.0F, 0.0F, 0.0F, 0.0F};
-  std::array<float, n_bands> reduction_port_array = {0.0F, 0.0F, 0.0F, 0.0F, 0.0F, 0.0F, 0.0F, 0.0F};
+  std::array<std::atomic<float>, n_bands> frequency_range_end_port_array{};
+  std::array<std::atomic<float>, n_bands> envelope_port_array{};
+  std::array<std::atomic<float>, n_bands> curve_port_array{};
+  std::array<std::atomic<float>, n_bands> reduction_port_array{};
 
  private:
   uint latency_n_frames = 0U;
 
   std::unique_ptr<lv2::Lv2Wrapper> lv2_wrapper;
+
+  void emit_meters() override;
+
+  auto set_realtime_parameter(const std::string& key, const Glib::VariantBase& value) -> bool override;
 };
 
 #endif
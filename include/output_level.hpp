@@ -40,6 +40,22 @@ class OutputLevel : public PluginBase {
                std::span<float>& right_in,
                std::span<float>& left_out,
                std::span<float>& right_out) override;
+
+  /*
+    Linear fades of the pipeline output. They are used to hide the discontinuities caused by a preset change. The
+    duration is in seconds.
+  */
+
+  void fade_out(const float& duration);
+
+  void fade_in(const float& duration);
+
+ private:
+  std::atomic<float> fade_target = 1.0F;
+
+  std::atomic<float> fade_duration = 0.0F;
+
+  float fade_gain = 1.0F;
 };
 
 #endif
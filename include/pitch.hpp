@@ -22,6 +22,8 @@
 
 #include <rubberband/RubberBandStretcher.h>
 #include <deque>
+#include <memory>
+#include <thread>
 #include "plugin_base.hpp"
 
 class Pitch : public PluginBase {
@@ -54,6 +56,12 @@ class Pitch : public PluginBase {
   int octaves = 0;
 
   uint latency_n_frames = 0U;
+  uint stretcher_rate = 0U;
+  uint stretcher_max_process_size = 0U;
+
+  // quantum changes up to this size do not require a new stretcher
+
+  static constexpr uint min_max_process_size = 8192U;
 
   double time_ratio = 1.0;
 
@@ -64,13 +72,22 @@ class Pitch : public PluginBase {
 
   std::deque<float> deque_out_L, deque_out_R;
 
-  RubberBand::RubberBandStretcher* stretcher = nullptr;
+  std::unique_ptr<RubberBand::RubberBandStretcher> stretcher;
+
+  /*
+    New stretchers are created and primed in this thread while the current one keeps running. The new one replaces
+    the current one at a block boundary.
+  */
+
+  std::jthread builder;
+
+  void update_crispness(RubberBand::RubberBandStretcher* s) const;
 
-  void update_crispness();
+  void update_pitch_scale(RubberBand::RubberBandStretcher* s) const;
 
-  void update_pitch_scale();
+  void configure_stretcher(RubberBand::RubberBandStretcher* s) const;
 
-  void init_stretcher();
+  void build_stretcher(const std::stop_token& stoken, const uint& new_rate, const uint& max_process_size);
 };
 
 #endif
@@ -21,11 +21,13 @@
 #define PLOT_UI_HPP
 
 #include <gtkmm.h>
+#include <algorithm>
 #include <iomanip>
+#include <limits>
 #include <ranges>
 #include "util.hpp"
 
-enum class PlotType { bar, line };
+enum class PlotType { bar, line, spectrogram };
 
 enum class PlotScale { linear, logarithmic };
 
@@ -96,13 +98,61 @@ class Plot {
 
   Glib::ustring x_unit, y_unit;
 
-  std::vector<float> original_x, original_y;
-  std::vector<float> y_axis, x_axis;
+  std::vector<float> y_axis;  // the y values are normalized only for the points that are drawn
 
-  void init_axes();
+  // the x coordinate of each point. It is computed again only when the width or the number of points changes
+
+  std::vector<float> objects_x;
+
+  int objects_x_width = 0;
+
+  /*
+    When there are more points than pixel columns each column is drawn once using the minimum and the maximum of the
+    points that fall in it. The cost of drawing does not depend on the number of points.
+  */
+
+  std::vector<float> columns_min, columns_max;
+
+  // the x axis labels are laid out again only when the axis range, its units or the number of labels change
+
+  std::vector<Glib::RefPtr<Pango::Layout>> x_labels;
+
+  int x_labels_height = 0;
+
+  bool x_labels_valid = false;
+
+  /*
+    The spectrogram history is kept in an image surface used as a ring of rows. Each new data set is written in a
+    single row and drawing is just blitting the surface in two pieces. The cost of both operations does not depend on
+    how much history is shown.
+  */
+
+  static constexpr int spectrogram_history = 256;
+
+  int spectrogram_row = 0;  // the row the next data set is written to. It is also the oldest row
+
+  // the y values that are mapped to the first and to the last color of the spectrogram
+
+  const float spectrogram_min = util::minimum_db_level, spectrogram_max = 0.0F;
+
+  Cairo::RefPtr<Cairo::ImageSurface> spectrogram_surface;
+
+  Cairo::RefPtr<Cairo::SurfacePattern> spectrogram_pattern;
+
+  void init_axes(const std::vector<float>& x, const std::vector<float>& y);
+
+  void write_spectrogram_row(const std::vector<float>& y);
+
+  void update_objects_x(const int& width);
+
+  void decimate(const int& width);
+
+  void build_x_labels();
 
   void on_draw(const Cairo::RefPtr<Cairo::Context>& ctx, const int& width, const int& height);
 
+  void draw_spectrogram(const Cairo::RefPtr<Cairo::Context>& ctx, const int& width, const int& height);
+
   auto draw_x_labels(const Cairo::RefPtr<Cairo::Context>& ctx, const int& width, const int& height) -> int;
 };
 
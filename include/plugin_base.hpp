@@ -23,6 +23,9 @@
 #include <giomm.h>
 #include <pipewire/filter.h>
 #include <spa/param/latency-utils.h>
+#include <array>
+#include <atomic>
+#include <map>
 #include <mutex>
 #include <ranges>
 #include <span>
@@ -78,6 +81,13 @@ class PluginBase {
 
   bool bypass = false;
 
+  /*
+    Set by the voice activity gate of a plugin placed before this one. While it is true the output of this plugin is
+    replaced by silence.
+  */
+
+  std::atomic<bool> vad_gate_closed = false;
+
   bool connected_to_pw = false;
 
   bool post_messages = false;
@@ -104,11 +114,38 @@ class PluginBase {
                        std::span<float>& probe_left,
                        std::span<float>& probe_right);
 
+  /*
+    The realtime thread only publishes the meter values. This method has to be called from the main thread, usually
+    once per display frame. It emits the level signals and the other meter signals of the plugin if new values were
+    published since the last call.
+  */
+
+  void update_meters();
+
+  /*
+    Used by the control interface. When the plugin can hand the parameter directly to the realtime thread the value is
+    kept in memory and written to the GSettings database at most once per parameters_apply_interval. This way external
+    automation can change a parameter many times per second without writing to dconf, waking every other GSettings
+    listener or locking data_mutex. The other parameters are written to the database right away.
+  */
+
+  auto set_parameter(const std::string& key, const Glib::VariantBase& value) -> bool;
+
+  [[nodiscard]] auto get_parameter(const std::string& key) const -> Glib::VariantBase;
+
   sigc::signal<void(const float&, const float&)> input_level;
   sigc::signal<void(const float&, const float&)> output_level;
 
+  sigc::signal<void(const std::string&)> parameter_changed;
+
  protected:
-  std::mutex data_mutex;
+  /*
+    It is held while GSettings emits the changed signals of a transaction, like a preset load. So the realtime thread
+    never processes a block with only part of the new values. It is recursive because the handlers of the changed
+    signals lock it too.
+  */
+
+  std::recursive_mutex data_mutex;
 
   Glib::RefPtr<Gio::Settings> settings;
 
@@ -118,18 +155,29 @@ class PluginBase {
 
   data pf_data = {};
 
-  float input_gain = 1.0F;
-  float output_gain = 1.0F;
+  std::atomic<float> input_gain = 1.0F;
+  std::atomic<float> output_gain = 1.0F;
 
   float notification_time_window = 1.0F / 20.0F;  // seconds
   float notification_dt = 0.0F;
 
   void setup_input_output_gain();
 
+  /*
+    Called by set_parameter in the main thread. The plugins that can pass the value to the realtime thread without
+    locking data_mutex, like the ones with a LV2 control port bound to the key, do it here and return true.
+  */
+
+  virtual auto set_realtime_parameter(const std::string& key, const Glib::VariantBase& value) -> bool;
+
   void initialize_listener();
 
   void notify();
 
+  // emits the meter signals that are specific to each plugin. It is called from update_meters in the main thread
+
+  virtual void emit_meters();
+
   void get_peaks(const std::span<float>& left_in,
                  const std::span<float>& right_in,
                  std::span<float>& left_out,
@@ -142,6 +190,31 @@ class PluginBase {
 
   float input_peak_left = util::minimum_linear_level, input_peak_right = util::minimum_linear_level;
   float output_peak_left = util::minimum_linear_level, output_peak_right = util::minimum_linear_level;
+
+  std::atomic<float> input_level_db_left = util::minimum_db_level, input_level_db_right = util::minimum_db_level;
+  std::atomic<float> output_level_db_left = util::minimum_db_level, output_level_db_right = util::minimum_db_level;
+
+  std::atomic<bool> meters_pending = false;
+
+  static constexpr uint parameters_apply_interval = 1000U;  // milliseconds
+
+  sigc::connection parameters_apply_timeout;
+
+  // values set through set_parameter that were not written to the database yet
+
+  std::map<std::string, Glib::VariantBase> pending_parameters;
+
+  // a second object for the same path. It writes the pending parameters in a single transaction
+
+  Glib::RefPtr<Gio::Settings> parameters_settings;
+
+  void apply_pending_parameters();
+
+  std::array<gulong, 2U> change_event_handlers{};
+
+  static auto on_change_event_begin(GSettings* settings, gpointer keys, gint n_keys, PluginBase* self) -> gboolean;
+
+  static auto on_change_event_end(GSettings* settings, gpointer keys, gint n_keys, PluginBase* self) -> gboolean;
 };
 
 #endif
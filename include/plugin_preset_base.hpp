@@ -50,23 +50,41 @@ class PluginPresetBase {
   }
 
   void read(PresetType preset_type, const nlohmann::json& json) {
+    const auto& settings = (preset_type == PresetType::output) ? output_settings : input_settings;
+    const auto& children = (preset_type == PresetType::output) ? output_child_settings : input_child_settings;
+
+    /*
+      In the delay-apply mode the values are only sent to the backend when apply is called. The whole preset of the
+      plugin is then written in a single transaction. The plugin gets a single change-event for it and the realtime
+      thread only sees the new values after all of them were handled (see PluginBase::data_mutex and Lv2Wrapper).
+    */
+
+    settings->delay();
+
+    for (const auto& child : children) {
+      child->delay();
+    }
+
     try {
-      switch (preset_type) {
-        case PresetType::output:
-          load(json, "output", output_settings);
-          break;
-        case PresetType::input:
-          load(json, "input", input_settings);
-          break;
-      }
+      load(json, (preset_type == PresetType::output) ? "output" : "input", settings);
     } catch (const nlohmann::json::exception& e) {
       util::warning(e.what());
     }
+
+    settings->apply();
+
+    for (const auto& child : children) {
+      child->apply();
+    }
   }
 
  protected:
   Glib::RefPtr<Gio::Settings> input_settings, output_settings;
 
+  // other settings objects written by load. They are applied in the same transaction as the main ones
+
+  std::vector<Glib::RefPtr<Gio::Settings>> input_child_settings, output_child_settings;
+
   virtual void save(nlohmann::json& json, const std::string& section, const Glib::RefPtr<Gio::Settings>& settings) = 0;
 
   virtual void load(const nlohmann::json& json,
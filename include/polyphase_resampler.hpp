@@ -0,0 +1,109 @@
+/*
+ *  Copyright © 2017-2022 Wellington Wallace
+ *
+ *  This file is part of EasyEffects.
+ *
+ *  EasyEffects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  EasyEffects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with EasyEffects.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef POLYPHASE_RESAMPLER_HPP
+#define POLYPHASE_RESAMPLER_HPP
+
+#include <sys/types.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <numbers>
+#include <span>
+#include <tuple>
+#include <vector>
+
+/*
+  Resampler for rational ratios up / down. It is a polyphase windowed-sinc FIR
+  https://en.wikipedia.org/wiki/Sample-rate_conversion#Rational_factors
+  Each output sample is the inner product of taps_per_phase input samples with one of the up phases of the filter.
+  The filter tables only depend on the ratio and are shared by all the instances using it. The latency is fixed and
+  the number of output frames is known before processing.
+*/
+
+class PolyphaseResampler {
+ public:
+  PolyphaseResampler(const uint& up, const uint& down, const uint& taps_per_phase, const int& n_channels);
+  PolyphaseResampler(const PolyphaseResampler&) = delete;
+  auto operator=(const PolyphaseResampler&) -> PolyphaseResampler& = delete;
+  PolyphaseResampler(const PolyphaseResampler&&) = delete;
+  auto operator=(const PolyphaseResampler&&) -> PolyphaseResampler& = delete;
+  ~PolyphaseResampler();
+
+  /*
+    The largest up and down terms we build tables for. It covers the ratios between all the common sampling rates. The
+    worst ones are 11025 Hz <-> 48000 Hz (640/147) and 11025 Hz <-> 16000 Hz (640/441). The table has up phases of
+    taps_per_phase * max(up, down) / up coefficients. For those ratios it takes less than 200 KiB and the filter
+    latency stays below 150 input samples. Other ratios fall back to libsamplerate.
+  */
+
+  static constexpr uint max_ratio_term = 640U;
+
+  void reserve(const size_t& max_input_frames);
+
+  void reset();
+
+  // the number of output frames a call with input_frames will generate
+
+  [[nodiscard]] auto get_output_frames(const size_t& input_frames) const -> size_t;
+
+  // the filter group delay in input frames
+
+  [[nodiscard]] auto get_latency() const -> float;
+
+  /*
+    Resamples one channel. The input and output samples of this channel are taken every stride samples so
+    interleaved buffers can be used directly. All channels must receive the same number of frames in each call.
+  */
+
+  auto process(const int& channel, std::span<const float> input, std::span<float> output, const size_t& stride = 1U)
+      -> size_t;
+
+ private:
+  uint up = 1U, down = 1U, taps = 0U;
+
+  /*
+    coefficients[p * taps + j] is the tap j of phase p. The taps are stored in reverse order so the inner product
+    walks the coefficients and the input samples in the same direction.
+  */
+
+  std::shared_ptr<const std::vector<float>> coefficients;
+
+  struct Channel {
+    uint phase = 0U;  // position between two input samples in units of 1 / up
+
+    size_t position = 0U;  // the newest input sample used by the next output sample
+
+    std::vector<float> buffer;  // the last taps - 1 input samples followed by the current block
+  };
+
+  std::vector<Channel> channels;
+
+  static auto get_coefficients(const uint& up, const uint& down, const uint& taps)
+      -> std::shared_ptr<const std::vector<float>>;
+
+  static auto create_coefficients(const uint& up, const uint& down, const uint& taps) -> std::vector<float>;
+
+  [[nodiscard]] auto inner_product(const float* coeffs, const float* samples) const -> float;
+};
+
+#endif
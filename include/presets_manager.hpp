@@ -26,8 +26,11 @@
 #include <algorithm>
 #include <filesystem>
 #include <fstream>
+#include <functional>
+#include <map>
 #include <memory>
 #include <nlohmann/json.hpp>
+#include <unordered_map>
 #include "autogain_preset.hpp"
 #include "bass_enhancer_preset.hpp"
 #include "bass_loudness_preset.hpp"
@@ -115,6 +118,13 @@ class PresetsManager {
   sigc::signal<void(const std::vector<nlohmann::json>& profiles)> autoload_input_profiles_changed;
   sigc::signal<void(const std::vector<nlohmann::json>& profiles)> autoload_output_profiles_changed;
 
+  /*
+    When set load_preset_file passes the function that applies the preset to it instead of calling it directly. This
+    way the pipeline can hide the change.
+  */
+
+  std::function<void(const PresetType&, const std::function<void()>&)> preset_transition;
+
  private:
   inline static const std::string log_tag = "presets_manager: ";
 
@@ -130,6 +140,29 @@ class PresetsManager {
 
   Glib::RefPtr<Gio::FileMonitor> autoload_output_monitor, autoload_input_monitor;
 
+  /*
+    In-memory index of the presets. The directories are scanned only once and the file monitors keep the index up to
+    date after that. The system directories are not monitored.
+  */
+
+  struct PresetIndex {
+    std::map<std::string, std::filesystem::path> user, system;  // preset name -> file
+
+    std::map<std::string, nlohmann::json> autoload;  // "device:profile" -> autoload file contents
+  };
+
+  PresetIndex input_index, output_index;
+
+  // presets already parsed. An entry is only used while the modification time of its file does not change
+
+  struct CachedPreset {
+    std::filesystem::file_time_type mtime;
+
+    std::shared_ptr<const nlohmann::json> json;
+  };
+
+  std::unordered_map<std::string, CachedPreset> preset_cache;
+
   std::unique_ptr<AutoGainPreset> autogain;
   std::unique_ptr<BassEnhancerPreset> bass_enhancer;
   std::unique_ptr<BassLoudnessPreset> bass_loudness;
@@ -159,6 +192,26 @@ class PresetsManager {
   void save_blocklist(const PresetType& preset_type, nlohmann::json& json);
 
   void load_blocklist(const PresetType& preset_type, const nlohmann::json& json);
+
+  void apply_preset_file(const PresetType& preset_type, const Glib::ustring& name);
+
+  auto get_index(const PresetType& preset_type) -> PresetIndex&;
+
+  void build_index(const PresetType& preset_type);
+
+  void update_user_index(const PresetType& preset_type,
+                         const Glib::RefPtr<Gio::File>& file,
+                         const Gio::FileMonitor::Event& event);
+
+  void update_autoload_index(const PresetType& preset_type,
+                             const Glib::RefPtr<Gio::File>& file,
+                             const Gio::FileMonitor::Event& event);
+
+  auto find_preset_file(const PresetType& preset_type, const Glib::ustring& name) -> std::filesystem::path;
+
+  auto get_preset_json(const std::filesystem::path& path) -> std::shared_ptr<const nlohmann::json>;
+
+  static auto read_autoload_file(const std::filesystem::path& path, nlohmann::json& json) -> bool;
 };
 
 #endif
@@ -21,56 +21,79 @@
 #define RESAMPLER_HPP
 
 #include <samplerate.h>
+#include <algorithm>
 #include <cmath>
+#include <memory>
+#include <numeric>
 #include <span>
 #include <vector>
+#include "polyphase_resampler.hpp"
+#include "util.hpp"
+
+enum class ResamplerQuality { fastest, medium, best };
+
+/*
+  Streaming wrapper around libsamplerate. With n_channels = 2 both channels share a single converter and are
+  interleaved internally. Rate pairs with a small integer ratio, like 44100 -> 48000 Hz = 160 / 147, are handled by a
+  polyphase filter instead of the libsamplerate generic sinc converter. After reserve() is called with the largest
+  block that will be processed the span methods do not allocate memory. So they can be used in the realtime thread.
+*/
 
 class Resampler {
  public:
-  Resampler(const int& input_rate, const int& output_rate);
+  Resampler(const int& input_rate,
+            const int& output_rate,
+            const int& n_channels = 1,
+            const ResamplerQuality& quality = ResamplerQuality::fastest);
   Resampler(const Resampler&) = delete;
   auto operator=(const Resampler&) -> Resampler& = delete;
   Resampler(const Resampler&&) = delete;
   auto operator=(const Resampler&&) -> Resampler& = delete;
   ~Resampler();
 
-  template <typename T>
-  auto process(const T& input, const bool& end_of_input) -> std::vector<float> {
-    output.resize(std::ceil(1.5 * resample_ratio * input.size()));
+  /*
+    The converter keeps part of the input inside its filter. So the number of frames generated by each call can be
+    off by one or two from input_frames * ratio. This is the largest number of frames a call with input_frames can
+    generate. Output spans of this size are never too small.
+  */
 
-    // The number of frames of data pointed to by data_in
-    src_data.input_frames = input.size();
+  [[nodiscard]] auto get_max_output_frames(const size_t& input_frames) const -> size_t;
 
-    // A pointer to the input data samples
-    src_data.data_in = input.data();
+  // it preallocates the internal buffers for blocks of up to max_input_frames frames
 
-    // Maximum number of frames pointed to by data_out
-    src_data.output_frames = static_cast<long>(output.size());
+  void reserve(const size_t& max_input_frames);
 
-    // A pointer to the output data samples
-    src_data.data_out = output.data();
+  void reset();
 
-    // Equal to output_sample_rate / input_sample_rate
-    src_data.src_ratio = resample_ratio;
+  /*
+    The span methods consume the whole input and return the number of frames written to the output. The input and
+    output of the single span version are interleaved when n_channels > 1.
+  */
 
-    // Equal to 0 if more input data is available and 1 otherwise
-    src_data.end_of_input = static_cast<int>(end_of_input);
+  auto process(std::span<const float> input, std::span<float> output, const bool& end_of_input = false) -> size_t;
 
-    src_process(src_state, &src_data);
+  auto process(std::span<const float> input_left,
+               std::span<const float> input_right,
+               std::span<float> output_left,
+               std::span<float> output_right,
+               const bool& end_of_input = false) -> size_t;
 
-    output.resize(src_data.output_frames_gen);
+  // one shot resampling of a whole buffer. It allocates the returned vector
 
-    return output;
-  }
+  auto process(const std::vector<float>& input, const bool& end_of_input) -> std::vector<float>;
 
  private:
-  float resample_ratio = 1.0F;
+  int n_channels = 1;
+
+  double resample_ratio = 1.0;
 
   SRC_STATE* src_state = nullptr;
 
+  std::unique_ptr<PolyphaseResampler> polyphase;
+
   SRC_DATA src_data{};
 
-  std::vector<float> output;
+  std::vector<float> interleaved_input, interleaved_output;
 };
 
 #endif
@@ -0,0 +1,71 @@
+/*
+ *  Copyright © 2017-2022 Wellington Wallace
+ *
+ *  This file is part of EasyEffects.
+ *
+ *  EasyEffects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  EasyEffects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with EasyEffects.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef RING_BUFFER_HPP
+#define RING_BUFFER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <span>
+#include <vector>
+
+/*
+  Lock-free single producer single consumer ring buffer of samples. It is used to move audio from the plugins
+  realtime thread to worker threads. The producer and the consumer never block each other and neither push nor pop
+  allocate memory. Only resize allocates and it must not be called while the buffer is in use.
+*/
+
+class RingBuffer {
+ public:
+  RingBuffer() = default;
+  RingBuffer(const RingBuffer&) = delete;
+  auto operator=(const RingBuffer&) -> RingBuffer& = delete;
+  RingBuffer(const RingBuffer&&) = delete;
+  auto operator=(const RingBuffer&&) -> RingBuffer& = delete;
+  ~RingBuffer() = default;
+
+  // the capacity is rounded up to a power of 2
+
+  void resize(const size_t& capacity);
+
+  void reset();
+
+  [[nodiscard]] auto capacity() const -> size_t;
+
+  [[nodiscard]] auto read_available() const -> size_t;
+
+  [[nodiscard]] auto write_available() const -> size_t;
+
+  // producer side. It returns how many samples were written. What does not fit is dropped
+
+  auto push(std::span<const float> data) -> size_t;
+
+  // consumer side. It returns how many samples were read
+
+  auto pop(std::span<float> data) -> size_t;
+
+ private:
+  std::vector<float> buffer;
+
+  size_t mask = 0U;
+
+  std::atomic<size_t> read_index = 0U, write_index = 0U;
+};
+
+#endif
@@ -20,9 +20,14 @@
 #ifndef RNNOISE_HPP
 #define RNNOISE_HPP
 
+#include <pthread.h>
 #include <rnnoise.h>
+#include <atomic>
 #include <deque>
+#include <filesystem>
+#include <map>
 #include <memory>
+#include <thread>
 #include "plugin_base.hpp"
 #include "resampler.hpp"
 
@@ -42,7 +47,11 @@ class RNNoise : public PluginBase {
                std::span<float>& left_out,
                std::span<float>& right_out) override;
 
-  sigc::signal<void(const float&)> latency;
+  // the plugins after this one in the pipeline. They are skipped while the voice activity gate is closed
+
+  void set_vad_gated_plugins(const std::vector<PluginBase*>& list);
+
+  sigc::signal<void(const float&)> latency, voice_activity;
 
  private:
   bool resample = false;
@@ -59,61 +68,109 @@ class RNNoise : public PluginBase {
   std::deque<float> deque_out_L, deque_out_R;
 
   std::vector<float> data_L, data_R;
+  std::vector<float> resampled_in_L, resampled_in_R;
   std::vector<float> resampled_data_L, resampled_data_R;
+  std::vector<float> resampled_out_L, resampled_out_R;
+
+  // both channels go through the same stereo resampler
 
-  std::unique_ptr<Resampler> resampler_inL, resampler_outL;
-  std::unique_ptr<Resampler> resampler_inR, resampler_outR;
+  std::unique_ptr<Resampler> resampler_in, resampler_out;
 
-  RNNModel* model = nullptr;
+  // nullptr is the built-in model. A model loaded from a file is shared by all instances using it
+
+  std::shared_ptr<RNNModel> model;
 
   DenoiseState *state_left = nullptr, *state_right = nullptr;
 
-  auto get_model_from_file() -> RNNModel*;
+  // the new model and its states are prepared in this thread. The realtime thread only sees them swapped in
+
+  std::jthread model_loader;
+
+  static auto get_model(const std::string& path) -> std::shared_ptr<RNNModel>;
+
+  void load_model(const std::string& path);
 
   void free_rnnoise();
 
-  template <typename T1, typename T2>
-  void remove_noise(const T1& left_in, const T1& right_in, T2& out_L, T2& out_R) {
-    for (const auto& v : left_in) {
-      data_L.push_back(v);
+  /*
+    stereo: both channels are denoised in the realtime thread
+    parallel_stereo: the right channel is denoised by a helper thread while the realtime thread does the left one
+    mono: the average of the channels is denoised once and written to both outputs. Good enough for microphones
+  */
 
-      if (data_L.size() == blocksize) {
-        if (state_left != nullptr) {
-          std::ranges::for_each(data_L, [](auto& v) { v *= static_cast<float>(SHRT_MAX + 1); });
+  enum class ChannelMode { stereo, parallel_stereo, mono };
 
-          rnnoise_process_frame(state_left, data_L.data(), data_L.data());
+  ChannelMode channel_mode = ChannelMode::stereo;
 
-          std::ranges::for_each(data_L, [&](auto& v) { v *= inv_short_max; });
-        }
+  // true while the helper thread owns data_R
 
-        for (const auto& v : data_L) {
-          out_L.push_back(v);
-        }
+  std::atomic<bool> right_frame_pending = false;
 
-        data_L.resize(0);
-      }
-    }
+  float right_vad_probability = 0.0F;
+
+  /*
+    rnnoise gives the probability of voice in each frame. The gate closes after vad_hangover_frames frames in a row
+    below vad_threshold and opens again at the first frame above it.
+  */
+
+  bool vad_gate = false;
+  bool vad_gate_muted = false;
+
+  uint vad_hangover_frames = 30U;
+  uint frames_without_voice = 0U;
 
-    for (const auto& v : right_in) {
-      data_R.push_back(v);
+  float vad_threshold = 0.5F;
+  float vad_probability = 0.0F;  // the highest value since the last notification
+  std::atomic<float> voice_activity_value = 0.0F;
 
-      if (data_R.size() == blocksize) {
-        if (state_right != nullptr) {
-          std::ranges::for_each(data_R, [](auto& v) { v *= static_cast<float>(SHRT_MAX + 1); });
+  std::vector<PluginBase*> vad_gated_plugins;
 
-          rnnoise_process_frame(state_right, data_R.data(), data_R.data());
+  void update_vad_settings();
 
-          std::ranges::for_each(data_R, [&](auto& v) { v *= inv_short_max; });
+  void update_vad_gate(const float& probability);
+
+  void set_vad_gate_closed(const bool& state);
+
+  std::jthread right_worker;
+
+  void update_channel_mode();
+
+  void start_right_worker();
+
+  void stop_right_worker();
+
+  void run_right_worker(const std::stop_token& stoken);
+
+  auto denoise(DenoiseState* state, std::vector<float>& data) const -> float;
+
+  void process_frame();
+
+  template <typename T1, typename T2>
+  void remove_noise(const T1& left_in, const T1& right_in, T2& out_L, T2& out_R) {
+    // both channels are buffered together so each rnnoise frame has the left and the right samples of the same time
+
+    for (size_t n = 0U; n < left_in.size(); n++) {
+      data_L.push_back(left_in[n]);
+      data_R.push_back(right_in[n]);
+
+      if (data_L.size() == blocksize) {
+        process_frame();
+
+        for (const auto& v : data_L) {
+          out_L.push_back(v);
         }
 
         for (const auto& v : data_R) {
           out_R.push_back(v);
         }
 
+        data_L.resize(0);
         data_R.resize(0);
       }
     }
   }
+
+  void emit_meters() override;
 };
 
 #endif
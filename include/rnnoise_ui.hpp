@@ -40,6 +40,8 @@ class RNNoiseUi : public Gtk::Box, public PluginUiBase {
 
   void reset() override;
 
+  void on_new_voice_activity(const float& value);
+
  private:
   inline static const std::string log_tag = "rnnoise_ui: ";
 
@@ -55,6 +57,16 @@ class RNNoiseUi : public Gtk::Box, public PluginUiBase {
 
   Gtk::Label* active_model_name = nullptr;
 
+  Gtk::ComboBoxText* channel_mode = nullptr;
+
+  Gtk::LevelBar* voice_activity = nullptr;
+
+  Gtk::Label* voice_activity_label = nullptr;
+
+  Gtk::ToggleButton* vad_gate = nullptr;
+
+  Gtk::SpinButton *vad_threshold = nullptr, *vad_hangover = nullptr;
+
   Glib::RefPtr<Gtk::StringList> string_list;
 
   Glib::RefPtr<Gio::FileMonitor> folder_monitor;
@@ -21,8 +21,13 @@
 #define SPECTRUM_HPP
 
 #include <fftw3.h>
+#include <array>
+#include <atomic>
 #include <numbers>
+#include <thread>
+#include "fir_filter_base.hpp"
 #include "plugin_base.hpp"
+#include "ring_buffer.hpp"
 
 class Spectrum : public PluginBase {
  public:
@@ -43,7 +48,7 @@ class Spectrum : public PluginBase {
                std::span<float>& left_out,
                std::span<float>& right_out) override;
 
-  sigc::signal<void(uint, uint, std::vector<float>)> power;  // rate, nbands, magnitudes
+  sigc::signal<void(uint, const std::vector<float>&, const std::vector<float>&)> power;  // rate, freqs, magnitudes
 
  private:
   bool fftw_ready = false;
@@ -54,7 +59,107 @@ class Spectrum : public PluginBase {
 
   std::vector<float> real_input, output;
 
-  uint n_bands = 4096U, total_count = 0U;
+  uint n_bands = 4096U;
+
+  /*
+    Consecutive fft frames overlap by 75%. The display is refreshed every hop_size samples instead of every n_bands.
+  */
+
+  uint hop_size = n_bands / 4U;
+
+  static constexpr float smoothing = 0.5F;  // weight of the previous frame in the exponential average
+
+  /*
+    The realtime thread only writes the downmixed samples to this ring buffer. The window, the fft and the averaging
+    are done in the analysis worker.
+  */
+
+  RingBuffer ring;
+
+  std::jthread worker;
+
+  std::vector<float> window, frame, hop;
+
+  /*
+    Multiresolution mode. The signal is decimated by 2 once per octave and each octave gets its own small fft. So every
+    octave has the same number of bins and the bass resolution does not depend on a huge fft.
+    Octave k runs at rate / 2^k and contributes only the bins between 0.2 and 0.4 of its rate. The lowest octave also
+    gets the bins below that and the top one the bins up to the Nyquist frequency.
+  */
+
+  static constexpr uint n_octaves = 8U;
+
+  static constexpr uint octave_fft_size = 256U;
+
+  static constexpr uint octave_hop_size = octave_fft_size / 4U;
+
+  struct Octave {
+    uint position = 0U;  // where the next sample goes in the circular buffer
+
+    uint new_samples = 0U;
+
+    uint fir_position = 0U;
+
+    bool decimation_phase = false;
+
+    std::vector<float> samples;  // the last octave_fft_size samples
+
+    std::vector<float> fir_history;  // duplicated so the anti-aliasing filter reads contiguous memory
+
+    std::vector<float> power;
+  };
+
+  std::atomic<bool> multiresolution = false;
+
+  bool multiresolution_active = false;
+
+  uint analysis_rate = 0U;
+
+  std::atomic<uint> worker_rate = 0U;  // copy of the rate set in setup() for the analysis worker
+
+  std::vector<float> analysis_frequencies;
+
+  std::array<Octave, n_octaves> octaves;
+
+  std::vector<float> octave_window, octave_real_input, anti_aliasing_kernel;
+
+  fftwf_plan octave_plan = nullptr;
+
+  fftwf_complex* octave_complex_output = nullptr;
+
+  /*
+    Triple buffer used to hand the finished frames to the main thread. The worker always writes to the back buffer and
+    the main thread always reads the front one. The middle one is exchanged atomically. Its index is stored together
+    with a flag telling if it has a frame the main thread did not see yet.
+  */
+
+  static constexpr uint new_frame_flag = 4U;
+
+  struct Frame {
+    uint rate = 0U;
+
+    std::vector<float> frequencies, magnitudes;
+  };
+
+  std::array<Frame, 3U> frames;
+
+  uint back_index = 0U, front_index = 2U;
+
+  std::atomic<uint> middle_index = 1U;
+
+  std::atomic<bool> idle_pending = false;
+
+  void run_analysis(const std::stop_token& stoken);
+
+  void reset_analysis();
+
+  void analyze_frame();
+
+  void push_octave_sample(const uint& k, const float& value);
+
+  void analyze_octave(const uint& k);
+
+  void publish_frame();
 };
 
 #endif
@@ -45,7 +45,7 @@ class SpectrumSettingsUi : public Gtk::Box {
 
   Application* app = nullptr;
 
-  Gtk::Switch *show = nullptr, *fill = nullptr, *show_bar_border = nullptr;
+  Gtk::Switch *show = nullptr, *fill = nullptr, *show_bar_border = nullptr, *multiresolution = nullptr;
 
   Gtk::ColorButton *spectrum_color_button = nullptr, *axis_color_button = nullptr;
 
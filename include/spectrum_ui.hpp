@@ -37,7 +37,7 @@ class SpectrumUi : public Gtk::DrawingArea {
 
   static auto add_to_box(Gtk::Box* box) -> SpectrumUi*;
 
-  void on_new_spectrum(uint rate, uint n_bands, std::vector<float> magnitudes);
+  void on_new_spectrum(uint rate, const std::vector<float>& frequencies, const std::vector<float>& magnitudes);
 
  private:
   inline static const std::string log_tag = "spectrum_ui: ";
@@ -48,11 +48,24 @@ class SpectrumUi : public Gtk::DrawingArea {
 
   std::vector<sigc::connection> connections;
 
-  uint rate = 0U, n_bands = 0U;
+  uint rate = 0U;
 
   std::vector<float> spectrum_mag, spectrum_freqs, spectrum_x_axis;
 
-  std::vector<uint> spectrum_bin_count;
+  /*
+    The spectrum bins that belong to each plot point. It is calculated only when the rate, the bins frequencies or the
+    plot axis change. Points without any bin are interpolated from the two bins around their frequency.
+  */
+
+  struct PointBins {
+    uint start = 0U, end = 0U;
+
+    uint interpolation_bin = 0U;
+
+    float interpolation_weight = 0.0F;
+  };
+
+  std::vector<PointBins> spectrum_point_bins;
 
   void init_color();
 
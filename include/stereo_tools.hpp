@@ -44,10 +44,14 @@ class StereoTools : public PluginBase {
 
   sigc::signal<void(const double&)> new_correlation;
 
-  double correlation_port_value = 0.0;
+  std::atomic<double> correlation_port_value = 0.0;
 
  private:
   std::unique_ptr<lv2::Lv2Wrapper> lv2_wrapper;
+
+  void emit_meters() override;
+
+  auto set_realtime_parameter(const std::string& key, const Glib::VariantBase& value) -> bool override;
 };
 
 #endif
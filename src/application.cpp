@@ -51,6 +51,10 @@ auto Application::create() -> Glib::RefPtr<Application> {
 }
 
 auto Application::on_command_line(const Glib::RefPtr<Gio::ApplicationCommandLine>& command_line) -> int {
+  if (core == nullptr) {
+    return EXIT_FAILURE;
+  }
+
   const auto& options = command_line->get_options_dict();
 
   if (options->contains("quit")) {
@@ -65,13 +69,7 @@ auto Application::on_command_line(const Glib::RefPtr<Gio::ApplicationCommandLine
     if (!options->lookup_value("load-preset", name)) {
       util::debug(log_tag + "failed to load preset: " + name);
     } else {
-      if (presets_manager->preset_file_exists(PresetType::input, name)) {
-        presets_manager->load_preset_file(PresetType::input, name);
-      }
-
-      if (presets_manager->preset_file_exists(PresetType::output, name)) {
-        presets_manager->load_preset_file(PresetType::output, name);
-      }
+      core->load_preset(name.raw());
     }
   } else if (options->contains("reset")) {
     settings->reset("");
@@ -105,8 +103,6 @@ void Application::on_startup() {
   util::debug(log_tag + "easyeffects version: " + std::string(VERSION));
 
   settings = Gio::Settings::create("com.github.wwmm.easyeffects");
-  soe_settings = Gio::Settings::create("com.github.wwmm.easyeffects.streamoutputs");
-  sie_settings = Gio::Settings::create("com.github.wwmm.easyeffects.streaminputs");
 
   if (static_cast<int>(get_flags() & Gio::Application::Flags::IS_SERVICE) != 0) {
     running_as_service = true;
@@ -114,157 +110,17 @@ void Application::on_startup() {
 
   create_actions();
 
-  pm = std::make_unique<PipeManager>();
-  soe = std::make_unique<StreamOutputEffects>(pm.get());
-  sie = std::make_unique<StreamInputEffects>(pm.get());
-
-  if (presets_manager == nullptr) {
-    presets_manager = std::make_unique<PresetsManager>();
-  }
-
-  pm->new_default_sink.connect([&](const NodeInfo node) {
-    util::debug("new default output device: " + node.name);
-
-    if (soe_settings->get_boolean("use-default-output-device")) {
-      /*
-        Depending on the hardware headphones can cause a node recreation here the id and the name are kept.
-        So we clear the key to force the callbacks to be called
-      */
-
-      soe_settings->set_string("output-device", "");
-      soe_settings->set_string("output-device", node.name);
-    }
-  });
-
-  pm->new_default_source.connect([&](const NodeInfo node) {
-    util::debug("new default input device: " + node.name);
-
-    if (sie_settings->get_boolean("use-default-input-device")) {
-      /*
-        Depending on the hardware microphones can cause a node recreation hwere the id and the name are kept.
-        So we clear the key to force the callbacks to be called
-      */
-
-      sie_settings->set_string("input-device", "");
-      sie_settings->set_string("input-device", node.name);
-    }
-  });
-
-  pm->device_input_route_changed.connect([&](const DeviceInfo device) {
-    if (device.input_route_available == SPA_PARAM_AVAILABILITY_no) {
-      return;
-    }
-
-    util::debug(log_tag + "device " + device.name + " has changed its input route to: " + device.input_route_name);
-
-    NodeInfo target_node;
-
-    for (const auto& [ts, node] : pm->node_map) {
-      if (node.device_id == device.id && node.media_class == pm->media_class_source) {
-        target_node = node;
-
-        break;
-      }
-    }
-
-    if (target_node.id != SPA_ID_INVALID) {
-      if (target_node.name.c_str() == sie_settings->get_string("input-device")) {
-        presets_manager->autoload(PresetType::input, target_node.name, device.input_route_name);
-      } else {
-        util::debug(log_tag + "input autoloading: the target node name does not match the input device name");
-      }
-    } else {
-      util::debug(log_tag + "input autoloading: could not find the target node");
-    }
-  });
-
-  pm->device_output_route_changed.connect([&](const DeviceInfo device) {
-    if (device.output_route_available == SPA_PARAM_AVAILABILITY_no) {
-      return;
-    }
-
-    util::debug(log_tag + "device " + device.name + " has changed its output route to: " + device.output_route_name);
-
-    NodeInfo target_node;
-
-    for (const auto& [ts, node] : pm->node_map) {
-      if (node.device_id == device.id && node.media_class == pm->media_class_sink) {
-        target_node = node;
-
-        break;
-      }
-    }
-
-    if (target_node.id != SPA_ID_INVALID) {
-      if (target_node.name.c_str() == soe_settings->get_string("output-device")) {
-        presets_manager->autoload(PresetType::output, target_node.name, device.output_route_name);
-      } else {
-        util::debug(log_tag + "output autoloading: the target node name does not match the output device name");
-      }
-    } else {
-      util::debug(log_tag + "output autoloading: could not find the target node");
-    }
-  });
-
-  soe_settings->signal_changed("output-device").connect([&, this](const auto& key) {
-    const auto name = soe_settings->get_string(key).raw();
-
-    if (name.empty()) {
-      return;
-    }
-
-    uint device_id = SPA_ID_INVALID;
-
-    for (const auto& [ts, node] : pm->node_map) {
-      if (node.name == name) {
-        device_id = node.device_id;
-
-        break;
-      }
-    }
-
-    if (device_id != SPA_ID_INVALID) {
-      for (const auto& device : pm->list_devices) {
-        if (device.id == device_id) {
-          presets_manager->autoload(PresetType::output, name, device.output_route_name);
-
-          break;
-        }
-      }
-    }
-  });
-
-  sie_settings->signal_changed("input-device").connect([&, this](const auto& key) {
-    const auto name = sie_settings->get_string(key).raw();
-
-    if (name.empty()) {
-      return;
-    }
+  if (!Core::claim_bus_name(get_dbus_connection())) {
+    util::warning(log_tag + "easyeffectsd is already running. Quit it before starting EasyEffects");
 
-    uint device_id = SPA_ID_INVALID;
-
-    for (const auto& [ts, node] : pm->node_map) {
-      if (node.name == name) {
-        device_id = node.device_id;
-
-        break;
-      }
-    }
-
-    if (device_id != SPA_ID_INVALID) {
-      for (const auto& device : pm->list_devices) {
-        if (device.id == device_id) {
-          presets_manager->autoload(PresetType::input, name, device.input_route_name);
+    quit();
 
-          break;
-        }
-      }
-    }
-  });
+    return;
+  }
 
-  settings->signal_changed("bypass").connect([=, this](const auto& key) { update_bypass_state(key); });
+  core = std::make_unique<Core>();
 
-  update_bypass_state("bypass");
+  core->export_control_interface(get_dbus_connection());
 
   if (running_as_service) {
     util::debug(log_tag + "Running in Background");
@@ -274,6 +130,10 @@ void Application::on_startup() {
 }
 
 void Application::on_activate() {
+  if (core == nullptr) {
+    return;
+  }
+
   if (get_active_window() == nullptr) {
     /*
       Note to myself: do not wrap this pointer in a smart pointer. Causes memory leaks when closing the window because
@@ -320,14 +180,12 @@ auto Application::on_handle_local_options(const Glib::RefPtr<Glib::VariantDict>&
   // instance, so they won't be passed to the primary (remote) instance:
   options->remove("preset");
 
-  if (presets_manager == nullptr) {
-    presets_manager = std::make_unique<PresetsManager>();
-  }
-
   if (options->contains("presets")) {
+    PresetsManager presets_manager;
+
     std::string list;
 
-    for (const auto& name : presets_manager->get_names(PresetType::output)) {
+    for (const auto& name : presets_manager.get_names(PresetType::output)) {
       list += name + ",";
     }
 
@@ -335,7 +193,7 @@ auto Application::on_handle_local_options(const Glib::RefPtr<Glib::VariantDict>&
 
     list = "";
 
-    for (const auto& name : presets_manager->get_names(PresetType::input)) {
+    for (const auto& name : presets_manager.get_names(PresetType::input)) {
       list += name + ",";
     }
 
@@ -397,12 +255,3 @@ void Application::create_actions() {
   set_accel_for_action("app.help", "F1");
   set_accel_for_action("app.quit", "<Ctrl>Q");
 }
-
-void Application::update_bypass_state(const Glib::ustring& key) {
-  const auto& state = settings->get_boolean(key);
-
-  soe->set_bypass(state);
-  sie->set_bypass(state);
-
-  util::info(log_tag + ((state) ? "enabling" : "disabling") + " global bypass");
-}
@@ -41,9 +41,9 @@ ApplicationUi::ApplicationUi(BaseObjectType* cobject,
 
   auto icon_theme = setup_icon_theme();
 
-  soe_ui = StreamOutputEffectsUi::add_to_stack(stack, app->soe.get(), icon_theme);
-  sie_ui = StreamInputEffectsUi::add_to_stack(stack, app->sie.get(), icon_theme);
-  pipe_info_ui = PipeInfoUi::add_to_stack(stack, app->pm.get(), app->presets_manager.get());
+  soe_ui = StreamOutputEffectsUi::add_to_stack(stack, app->core->soe.get(), icon_theme);
+  sie_ui = StreamInputEffectsUi::add_to_stack(stack, app->core->sie.get(), icon_theme);
+  pipe_info_ui = PipeInfoUi::add_to_stack(stack, app->core->pm.get(), app->core->presets_manager.get());
 
   presets_menu_button->set_popover(*presets_menu_ui);
 
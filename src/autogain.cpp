@@ -28,13 +28,17 @@ AutoGain::AutoGain(const std::string& tag,
 
   settings->signal_changed("target").connect([&, this](const auto& key) { target = settings->get_double(key); });
 
-  settings->signal_changed("reset-history").connect([&, this](const auto& key) {
-    std::scoped_lock<std::mutex> lock(data_mutex);
-
-    init_ebur128();
-  });
+  settings->signal_changed("reset-history").connect([&, this](const auto& key) { reset_history = true; });
 
   setup_input_output_gain();
+
+  // more than one second of stereo audio at 48 kHz. The worker empties it every control period
+
+  ring.resize(2U * 65536U);
+
+  data.resize(ring.capacity());
+
+  worker = std::jthread([this](const std::stop_token& stoken) { run_worker(stoken); });
 }
 
 AutoGain::~AutoGain() {
@@ -42,7 +46,13 @@ AutoGain::~AutoGain() {
     disconnect_from_pw();
   }
 
-  std::scoped_lock<std::mutex> lock(data_mutex);
+  worker.request_stop();
+
+  if (worker.joinable()) {
+    worker.join();
+  }
+
+  std::scoped_lock<std::recursive_mutex> lock(data_mutex);
 
   if (ebur_state != nullptr) {
     ebur128_destroy(&ebur_state);
@@ -52,46 +62,47 @@ AutoGain::~AutoGain() {
 }
 
 void AutoGain::init_ebur128() {
-  ebur128_ready = false;
-
-  if (n_samples == 0 || rate == 0) {
-    return;
-  }
-
   if (ebur_state != nullptr) {
     ebur128_destroy(&ebur_state);
 
     ebur_state = nullptr;
   }
 
-  ebur_state = ebur128_init(
-      2U, rate, EBUR128_MODE_S | EBUR128_MODE_I | EBUR128_MODE_LRA | EBUR128_MODE_SAMPLE_PEAK | EBUR128_MODE_HISTOGRAM);
+  if (ebur_rate == 0U) {
+    return;
+  }
+
+  ebur_state = ebur128_init(2U, ebur_rate,
+                            EBUR128_MODE_S | EBUR128_MODE_I | EBUR128_MODE_LRA | EBUR128_MODE_SAMPLE_PEAK |
+                                EBUR128_MODE_HISTOGRAM);
+
+  if (ebur_state == nullptr) {
+    return;
+  }
 
   ebur128_set_channel(ebur_state, 0U, EBUR128_LEFT);
   ebur128_set_channel(ebur_state, 1U, EBUR128_RIGHT);
-
-  ebur128_ready = ebur_state != nullptr;
 }
 
 void AutoGain::setup() {
-  std::scoped_lock<std::mutex> lock(data_mutex);
+  std::scoped_lock<std::recursive_mutex> lock(data_mutex);
 
-  if (rate != old_rate) {
-    old_rate = rate;
+  // the gain moves towards the target with the same time constant whatever the block size is
 
-    init_ebur128();
-  }
+  gain_smoothing = 1.0F - std::exp(-sample_duration / gain_time_constant);
+
+  // the worker can not read the rate member. It is written by the PipeWire thread
 
-  data.resize(n_samples * 2);
+  worker_rate.store(rate, std::memory_order_relaxed);
 }
 
 void AutoGain::process(std::span<float>& left_in,
                        std::span<float>& right_in,
                        std::span<float>& left_out,
                        std::span<float>& right_out) {
-  std::scoped_lock<std::mutex> lock(data_mutex);
+  std::scoped_lock<std::recursive_mutex> lock(data_mutex);
 
-  if (bypass || !ebur128_ready) {
+  if (bypass) {
     std::copy(left_in.begin(), left_in.end(), left_out.begin());
     std::copy(right_in.begin(), right_in.end(), right_out.begin());
 
@@ -102,42 +113,114 @@ void AutoGain::process(std::span<float>& left_in,
     apply_gain(left_in, right_in, input_gain);
   }
 
-  for (uint n = 0U; n < n_samples; n++) {
-    data[2U * n] = left_in[n];
-    data[2U * n + 1U] = right_in[n];
+  /*
+    The interleaving is done in small chunks on the stack so nothing is allocated here. The loop has no dependencies
+    between iterations and the compiler turns it into vector shuffles.
+  */
+
+  std::array<float, 1024U> interleaved{};
+
+  for (size_t offset = 0U; offset < left_in.size(); offset += interleaved.size() / 2U) {
+    const auto count = std::min(interleaved.size() / 2U, left_in.size() - offset);
+
+    const float* left = left_in.data() + offset;
+    const float* right = right_in.data() + offset;
+
+    for (size_t n = 0U; n < count; n++) {
+      interleaved[2U * n] = left[n];
+      interleaved[2U * n + 1U] = right[n];
+    }
+
+    ring.push(std::span{interleaved.data(), 2U * count});
+  }
+
+  // ramping the gain along the block avoids zipper noise when the target changes
+
+  const float next_gain = gain + (target_gain.load(std::memory_order_relaxed) - gain) * gain_smoothing;
+
+  const float step = (next_gain - gain) / static_cast<float>(left_in.size());
+
+  for (size_t n = 0U; n < left_in.size(); n++) {
+    const float g = gain + step * static_cast<float>(n + 1U);
+
+    left_out[n] = left_in[n] * g;
+    right_out[n] = right_in[n] * g;
+  }
+
+  gain = next_gain;
+
+  if (output_gain != 1.0F) {
+    apply_gain(left_out, right_out, output_gain);
   }
 
-  ebur128_add_frames_float(ebur_state, data.data(), n_samples);
+  if (post_messages) {
+    get_peaks(left_in, right_in, left_out, right_out);
 
+    notification_dt += sample_duration;
+
+    if (notification_dt >= notification_time_window) {
+      gain_value = gain;
+
+      notify();
+
+      notification_dt = 0.0F;
+    }
+  }
+}
+
+void AutoGain::run_worker(const std::stop_token& stoken) {
+  while (!stoken.stop_requested()) {
+    if (const uint current_rate = worker_rate.load(std::memory_order_relaxed);
+        current_rate != ebur_rate || reset_history.exchange(false)) {
+      ebur_rate = current_rate;
+
+      init_ebur128();
+    }
+
+    // the ring only receives whole frames. So the number of samples available is always even
+
+    if (const auto& n_frames = ring.read_available() / 2U; ebur_state != nullptr && n_frames > 0U) {
+      ring.pop(std::span{data.data(), 2U * n_frames});
+
+      ebur128_add_frames_float(ebur_state, data.data(), n_frames);
+
+      update_gain();
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(static_cast<int>(1000.0F * control_period)));
+  }
+}
+
+void AutoGain::update_gain() {
   auto failed = false;
-  double momentary = 0.0;
-  double shortterm = 0.0;
-  double global = 0.0;
-  double relative = 0.0;
-  double range = 0.0;
-  double loudness = 0.0;
-
-  if (EBUR128_SUCCESS != ebur128_loudness_momentary(ebur_state, &momentary)) {
+  double new_momentary = 0.0;
+  double new_shortterm = 0.0;
+  double new_global = 0.0;
+  double new_relative = 0.0;
+  double new_range = 0.0;
+  double new_loudness = 0.0;
+
+  if (EBUR128_SUCCESS != ebur128_loudness_momentary(ebur_state, &new_momentary)) {
     failed = true;
   }
 
-  if (EBUR128_SUCCESS != ebur128_loudness_shortterm(ebur_state, &shortterm)) {
+  if (EBUR128_SUCCESS != ebur128_loudness_shortterm(ebur_state, &new_shortterm)) {
     failed = true;
   }
 
-  if (EBUR128_SUCCESS != ebur128_loudness_global(ebur_state, &global)) {
+  if (EBUR128_SUCCESS != ebur128_loudness_global(ebur_state, &new_global)) {
     failed = true;
   }
 
-  if (EBUR128_SUCCESS != ebur128_relative_threshold(ebur_state, &relative)) {
+  if (EBUR128_SUCCESS != ebur128_relative_threshold(ebur_state, &new_relative)) {
     failed = true;
   }
 
-  if (EBUR128_SUCCESS != ebur128_loudness_range(ebur_state, &range)) {
+  if (EBUR128_SUCCESS != ebur128_loudness_range(ebur_state, &new_range)) {
     failed = true;
   }
 
-  if (relative > -70.0F && momentary > -70.0F && !failed) {
+  if (new_relative > -70.0F && new_momentary > -70.0F && !failed) {
     double peak_L = 0.0;
     double peak_R = 0.0;
 
@@ -150,48 +233,34 @@ void AutoGain::process(std::span<float>& left_in,
     }
 
     if (!failed) {
-      loudness = std::cbrt(momentary * shortterm * global);
+      new_loudness = std::cbrt(new_momentary * new_shortterm * new_global);
 
-      const double diff = target - loudness;
+      const double diff = target - new_loudness;
 
       // 10^(diff/20). The way below should be faster than using pow
-      const double gain = std::exp((diff / 20.0) * std::log(10.0));
+      const double new_gain = std::exp((diff / 20.0) * std::log(10.0));
 
       const double peak = (peak_L > peak_R) ? peak_L : peak_R;
 
       const auto& db_peak = util::linear_to_db(peak);
 
       if (db_peak > util::minimum_db_level) {
-        if (gain * peak < 1.0) {
-          internal_output_gain = gain;
+        if (new_gain * peak < 1.0) {
+          target_gain = static_cast<float>(new_gain);
         }
       }
     }
   }
 
-  std::copy(left_in.begin(), left_in.end(), left_out.begin());
-  std::copy(right_in.begin(), right_in.end(), right_out.begin());
-
-  if (internal_output_gain != 1.0F) {
-    apply_gain(left_out, right_out, static_cast<float>(internal_output_gain));
-  }
-
-  if (output_gain != 1.0F) {
-    apply_gain(left_out, right_out, output_gain);
-  }
-
-  if (post_messages) {
-    get_peaks(left_in, right_in, left_out, right_out);
-
-    notification_dt += sample_duration;
-
-    if (notification_dt >= notification_time_window) {
-      Glib::signal_idle().connect_once(
-          [=, this] { results.emit(loudness, internal_output_gain, momentary, shortterm, global, relative, range); });
-
-      notify();
+  loudness = new_loudness;
+  momentary = new_momentary;
+  shortterm = new_shortterm;
+  global = new_global;
+  relative = new_relative;
+  range = new_range;
+}
 
-      notification_dt = 0.0F;
-    }
-  }
+void AutoGain::emit_meters() {
+  results.emit(loudness.load(), gain_value.load(), momentary.load(), shortterm.load(), global.load(), relative.load(),
+               range.load());
 }
@@ -176,7 +176,7 @@ void Compressor::process(std::span<float>& left_in,
 
     util::debug(log_tag + name + " latency: " + std::to_string(latency_port_value) + " s");
 
-    Glib::signal_idle().connect_once([=, this] { latency.emit(latency_port_value); });
+    Glib::signal_idle().connect_once([=, this] { latency.emit(latency_port_value.load()); });
 
     spa_process_latency_info latency_info{};
 
@@ -204,16 +204,20 @@ void Compressor::process(std::span<float>& left_in,
       curve_port_value = lv2_wrapper->get_control_port_value("clm");
       envelope_port_value = lv2_wrapper->get_control_port_value("elm");
 
-      Glib::signal_idle().connect_once([=, this] {
-        reduction.emit(reduction_port_value);
-        sidechain.emit(sidechain_port_value);
-        curve.emit(curve_port_value);
-        envelope.emit(envelope_port_value);
-      });
-
       notify();
 
       notification_dt = 0.0F;
     }
   }
 }
+
+void Compressor::emit_meters() {
+  reduction.emit(reduction_port_value.load());
+  sidechain.emit(sidechain_port_value.load());
+  curve.emit(curve_port_value.load());
+  envelope.emit(envelope_port_value.load());
+}
+
+auto Compressor::set_realtime_parameter(const std::string& key, const Glib::VariantBase& value) -> bool {
+  return PluginBase::set_realtime_parameter(key, value) || lv2_wrapper->set_bound_key(settings, key, value);
+}
@@ -0,0 +1,172 @@
+/*
+ *  Copyright © 2017-2022 Wellington Wallace
+ *
+ *  This file is part of EasyEffects.
+ *
+ *  EasyEffects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  EasyEffects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with EasyEffects.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "control_interface.hpp"
+
+ControlInterface::ControlInterface(const Glib::RefPtr<Gio::DBus::Connection>& connection,
+                                   StreamOutputEffects* soe,
+                                   StreamInputEffects* sie)
+    : connection(connection),
+      soe(soe),
+      sie(sie),
+      interface_vtable(sigc::mem_fun(*this, &ControlInterface::on_method_call)) {
+  try {
+    const auto& node_info = Gio::DBus::NodeInfo::create_for_xml(introspection_xml);
+
+    registration_id = connection->register_object(object_path, node_info->lookup_interface(), interface_vtable);
+
+    util::debug(log_tag + "exported the control interface at " + object_path);
+  } catch (const Glib::Error& e) {
+    util::warning(log_tag + "could not export the control interface: " + e.what());
+
+    return;
+  }
+
+  connect_plugins("output", soe);
+  connect_plugins("input", sie);
+}
+
+ControlInterface::~ControlInterface() {
+  signals_timeout.disconnect();
+
+  for (auto& c : connections) {
+    c.disconnect();
+  }
+
+  if (registration_id != 0U) {
+    connection->unregister_object(registration_id);
+  }
+
+  util::debug(log_tag + "destroyed");
+}
+
+void ControlInterface::connect_plugins(const std::string& pipeline, EffectsBase* effects_base) {
+  for (const auto& [name, plugin] : effects_base->get_plugins_map()) {
+    connections.push_back(plugin->parameter_changed.connect([=, this, name = name](const auto& key) {
+      changed_parameters.emplace(pipeline, name, key);
+
+      if (!signals_timeout.connected()) {
+        signals_timeout = Glib::signal_timeout().connect(
+            [this]() {
+              emit_changed_parameters();
+
+              return false;
+            },
+            signals_interval);
+      }
+    }));
+  }
+}
+
+void ControlInterface::emit_changed_parameters() {
+  for (const auto& [pipeline, name, key] : changed_parameters) {
+    const auto& plugin = find_plugin(pipeline, name);
+
+    if (plugin == nullptr) {
+      continue;
+    }
+
+    const auto& value = plugin->get_parameter(key);
+
+    if (!value) {
+      continue;
+    }
+
+    const auto& parameters = Glib::VariantContainerBase::create_tuple(
+        {Glib::Variant<Glib::ustring>::create(pipeline), Glib::Variant<Glib::ustring>::create(name),
+         Glib::Variant<Glib::ustring>::create(key), Glib::Variant<Glib::VariantBase>::create(value)});
+
+    connection->emit_signal(object_path, interface_name, "ParameterChanged", {}, parameters);
+  }
+
+  changed_parameters.clear();
+}
+
+auto ControlInterface::find_plugin(const std::string& pipeline, const std::string& plugin)
+    -> std::shared_ptr<PluginBase> {
+  EffectsBase* effects_base = nullptr;
+
+  if (pipeline == "output") {
+    effects_base = soe;
+  } else if (pipeline == "input") {
+    effects_base = sie;
+  } else {
+    return nullptr;
+  }
+
+  const auto& plugins_map = effects_base->get_plugins_map();
+
+  if (const auto& it = plugins_map.find(plugin); it != plugins_map.end()) {
+    return it->second;
+  }
+
+  return nullptr;
+}
+
+void ControlInterface::on_method_call(const Glib::RefPtr<Gio::DBus::Connection>& connection,
+                                      const Glib::ustring& sender,
+                                      const Glib::ustring& object_path,
+                                      const Glib::ustring& interface_name,
+                                      const Glib::ustring& method_name,
+                                      const Glib::VariantContainerBase& parameters,
+                                      const Glib::RefPtr<Gio::DBus::MethodInvocation>& invocation) {
+  Glib::Variant<Glib::ustring> pipeline;
+  Glib::Variant<Glib::ustring> plugin_name;
+  Glib::Variant<Glib::ustring> key;
+
+  parameters.get_child(pipeline, 0);
+  parameters.get_child(plugin_name, 1);
+  parameters.get_child(key, 2);
+
+  const auto& plugin = find_plugin(pipeline.get(), plugin_name.get());
+
+  if (plugin == nullptr) {
+    invocation->return_error(Gio::DBus::Error(Gio::DBus::Error::INVALID_ARGS,
+                                              "unknown plugin: " + pipeline.get() + " " + plugin_name.get()));
+
+    return;
+  }
+
+  if (method_name == "SetParameter") {
+    Glib::Variant<Glib::VariantBase> value;
+
+    parameters.get_child(value, 3);
+
+    if (!plugin->set_parameter(key.get(), value.get())) {
+      invocation->return_error(
+          Gio::DBus::Error(Gio::DBus::Error::INVALID_ARGS, "invalid parameter or value: " + key.get()));
+
+      return;
+    }
+
+    invocation->return_value(Glib::VariantContainerBase());
+  } else if (method_name == "GetParameter") {
+    const auto& value = plugin->get_parameter(key.get());
+
+    if (!value) {
+      invocation->return_error(Gio::DBus::Error(Gio::DBus::Error::INVALID_ARGS, "unknown parameter: " + key.get()));
+
+      return;
+    }
+
+    invocation->return_value(Glib::VariantContainerBase::create_tuple(Glib::Variant<Glib::VariantBase>::create(value)));
+  } else {
+    invocation->return_error(Gio::DBus::Error(Gio::DBus::Error::UNKNOWN_METHOD, "unknown method: " + method_name));
+  }
+}
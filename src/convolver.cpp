@@ -35,7 +35,7 @@ Convolver::Convolver(const std::string& tag,
   settings->signal_changed("ir-width").connect([=, this](const auto& key) {
     ir_width = settings->get_int(key);
 
-    std::scoped_lock<std::mutex> lock(data_mutex);
+    std::scoped_lock<std::recursive_mutex> lock(data_mutex);
 
     if (kernel_is_initialized) {
       kernel_L = original_kernel_L;
@@ -57,23 +57,30 @@ Convolver::Convolver(const std::string& tag,
 
     data_mutex.unlock();
 
-    read_kernel_file();
+    /*
+      The kernel is loaded without holding data_mutex. When this key is part of a settings transaction the lock is
+      held until all the keys were handled. So the load waits for it to end.
+    */
 
-    if (kernel_is_initialized) {
-      kernel_L = original_kernel_L;
-      kernel_R = original_kernel_R;
+    Glib::signal_idle().connect_once([=, this] {
+      read_kernel_file();
 
-      set_kernel_stereo_width();
-      apply_kernel_autogain();
+      if (kernel_is_initialized) {
+        kernel_L = original_kernel_L;
+        kernel_R = original_kernel_R;
 
-      setup_zita();
+        set_kernel_stereo_width();
+        apply_kernel_autogain();
 
-      data_mutex.lock();
+        setup_zita();
 
-      ready = kernel_is_initialized && zita_ready;
+        data_mutex.lock();
 
-      data_mutex.unlock();
-    }
+        ready = kernel_is_initialized && zita_ready;
+
+        data_mutex.unlock();
+      }
+    });
   });
 
   setup_input_output_gain();
@@ -84,7 +91,7 @@ Convolver::~Convolver() {
     disconnect_from_pw();
   }
 
-  std::scoped_lock<std::mutex> lock(data_mutex);
+  std::scoped_lock<std::recursive_mutex> lock(data_mutex);
 
   ready = false;
 
@@ -141,7 +148,7 @@ void Convolver::setup() {
       setup_zita();
     }
 
-    std::scoped_lock<std::mutex> lock(data_mutex);
+    std::scoped_lock<std::recursive_mutex> lock(data_mutex);
 
     ready = kernel_is_initialized && zita_ready;
   });
@@ -151,7 +158,7 @@ void Convolver::process(std::span<float>& left_in,
                         std::span<float>& right_in,
                         std::span<float>& left_out,
                         std::span<float>& right_out) {
-  std::scoped_lock<std::mutex> lock(data_mutex);
+  std::scoped_lock<std::recursive_mutex> lock(data_mutex);
 
   if (bypass || !ready) {
     std::copy(left_in.begin(), left_in.end(), left_out.begin());
@@ -306,29 +313,28 @@ void Convolver::read_kernel_file() {
   }
 
   std::vector<float> buffer(file.frames() * file.channels());
-  std::vector<float> buffer_L(file.frames());
-  std::vector<float> buffer_R(file.frames());
 
   file.readf(buffer.data(), file.frames());
 
-  for (size_t n = 0U; n < buffer_L.size(); n++) {
-    buffer_L[n] = buffer[2U * n];
-    buffer_R[n] = buffer[2U * n + 1U];
-  }
-
   if (file.samplerate() != static_cast<int>(rate)) {
     util::debug(log_tag + name + " resampling the kernel to " + std::to_string(rate));
 
-    auto resampler = std::make_unique<Resampler>(file.samplerate(), rate);
+    /*
+      The file data is already interleaved. So both channels go through a single converter. This is done only when
+      the kernel is loaded and we can afford the best quality.
+    */
 
-    original_kernel_L = resampler->process(buffer_L, true);
+    auto resampler = std::make_unique<Resampler>(file.samplerate(), rate, 2, ResamplerQuality::best);
 
-    resampler = std::make_unique<Resampler>(file.samplerate(), rate);
+    buffer = resampler->process(buffer, true);
+  }
 
-    original_kernel_R = resampler->process(buffer_R, true);
-  } else {
-    original_kernel_L = buffer_L;
-    original_kernel_R = buffer_R;
+  original_kernel_L.resize(buffer.size() / 2U);
+  original_kernel_R.resize(buffer.size() / 2U);
+
+  for (size_t n = 0U; n < original_kernel_L.size(); n++) {
+    original_kernel_L[n] = buffer[2U * n];
+    original_kernel_R[n] = buffer[2U * n + 1U];
   }
 
   kernel_is_initialized = true;
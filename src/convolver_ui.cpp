@@ -101,24 +101,27 @@ ConvolverUi::ConvolverUi(BaseObjectType* cobject,
 
   setup_input_output_gain(builder);
 
-  // reading the current configured irs file
-
-  std::jthread jt{[this]() {
-    std::scoped_lock<std::mutex> lock(lock_guard_irs_info);
-
-    get_irs_info();
-  }};
-
   /* this is necessary to update the interface with the irs info when a preset
      is loaded
   */
 
-  connections.push_back(settings->signal_changed("kernel-path").connect([=, this](const auto& key) {
-    std::jthread jt{[this]() {
-      std::scoped_lock<std::mutex> lock(lock_guard_irs_info);
+  connections.push_back(
+      settings->signal_changed("kernel-path").connect([=, this](const auto& key) { get_irs_info(); }));
+
+  // the plots are rebuilt from the cached analysis. There is no need to read the file again
+
+  connections.push_back(spectrum_settings->signal_changed("n-points").connect([=, this](const auto& key) {
+    if (irs_info == nullptr) {
+      return;
+    }
 
-      get_irs_info();
-    }};
+    const auto& n_points = spectrum_settings->get_int("n-points");
+
+    decimate_waveform(n_points);
+
+    bin_spectrum(n_points);
+
+    (show_fft->get_active()) ? plot_fft() : plot_waveform();
   }));
 
   folder_monitor = Gio::File::create_for_path(irs_dir.string())->monitor_directory();
@@ -160,12 +163,30 @@ ConvolverUi::ConvolverUi(BaseObjectType* cobject,
             break;
         }
       });
+
+  /*
+    Reading and analyzing long impulse files can take a few seconds. This is done in a worker thread so the window does
+    not freeze while it is busy. It has to be started after all the connections above were made because the worker
+    also pushes to the connections vector.
+  */
+
+  irs_worker = std::jthread([this](const std::stop_token& stoken) { run_irs_worker(stoken); });
+
+  // reading the current configured irs file
+
+  get_irs_info();
 }
 
 ConvolverUi::~ConvolverUi() {
-  lock_guard_irs_info.lock();
+  irs_worker.request_stop();
 
-  lock_guard_irs_info.unlock();
+  if (irs_worker.joinable()) {
+    irs_worker.join();
+  }
+
+  if (irs_job.has_value()) {
+    destroy_irs_job(*irs_job);
+  }
 
   util::debug(name + " ui destroyed");
 }
@@ -385,287 +406,402 @@ void ConvolverUi::get_irs_info() {
     return;
   }
 
-  util::debug(log_tag + "reading the impulse file: " + path);
+  // there is no need to analyze the file again if it was not modified since the last time we read it
 
-  SndfileHandle file = SndfileHandle(path.c_str());
+  std::error_code ec;
 
-  if (file.channels() != 2 || file.frames() == 0) {
-    // warning user that there is a problem
+  const auto& mtime = std::filesystem::last_write_time(path.raw(), ec);
 
-    connections.push_back(Glib::signal_idle().connect([=, this]() {
-      label_sampling_rate->set_text(_("Failed"));
-      label_samples->set_text(_("Failed"));
+  std::shared_ptr<const IrsInfo> cached_info;
 
-      label_duration->set_text(_("Failed"));
+  {
+    std::scoped_lock<std::mutex> lock(lock_guard_irs_info);
 
-      label_file_name->set_text(_("Could Not Load The Impulse File"));
+    if (const auto& it = irs_info_cache.find(path.raw()); it != irs_info_cache.end() && !ec) {
+      if (it->second->mtime == mtime) {
+        cached_info = it->second;
+      }
+    }
+  }
 
-      return false;
-    }));
+  if (cached_info != nullptr) {
+    util::debug(log_tag + "using the cached information of the impulse file: " + path);
+
+    show_irs_info(path.raw(), cached_info);
 
     return;
   }
 
-  std::vector<float> kernel(file.channels() * file.frames());
+  SndfileHandle file = SndfileHandle(path.c_str());
 
-  file.readf(kernel.data(), file.frames());
+  if (file.channels() != 2 || file.frames() == 0) {
+    show_irs_failure();
 
-  const float dt = 1.0F / static_cast<float>(file.samplerate());
+    return;
+  }
 
-  const float duration = (static_cast<float>(file.frames()) - 1.0F) * dt;
+  IrsJob job;
 
-  time_axis.resize(file.frames());
-  left_mag.resize(file.frames());
-  right_mag.resize(file.frames());
+  job.path = path.raw();
+  job.frames = static_cast<int>(file.frames());
+  job.real_input = fftwf_alloc_real(job.frames);
+  job.complex_output = fftwf_alloc_complex(job.frames / 2 + 1);
+  job.plan = fftwf_plan_dft_r2c_1d(job.frames, job.real_input, job.complex_output, FFTW_ESTIMATE);
 
-  for (int n = 0; n < file.frames(); n++) {
-    time_axis[n] = n * dt;
+  {
+    std::scoped_lock<std::mutex> lock(lock_guard_irs_info);
 
-    left_mag[n] = kernel[2 * n];
+    // a request that the worker did not start yet is replaced by the new one
 
-    right_mag[n] = kernel[2 * n + 1];
+    if (irs_job.has_value()) {
+      destroy_irs_job(*irs_job);
+    }
+
+    irs_job = job;
   }
 
-  get_irs_spectrum(file.samplerate());
+  irs_job_cv.notify_one();
+}
 
-  if (file.frames() > spectrum_settings->get_int("n-points")) {
-    // decimating the data so we can draw it
+void ConvolverUi::run_irs_worker(const std::stop_token& stoken) {
+  while (!stoken.stop_requested()) {
+    IrsJob job;
 
-    std::vector<float> t;
-    std::vector<float> l;
-    std::vector<float> r;
-    std::vector<float> bin_x;
-    std::vector<float> bin_l_y;
-    std::vector<float> bin_r_y;
+    {
+      std::unique_lock<std::mutex> lock(lock_guard_irs_info);
 
-    size_t bin_size = std::ceil(file.frames() / spectrum_settings->get_int("n-points"));
+      if (!irs_job_cv.wait(lock, stoken, [this] { return irs_job.has_value(); })) {
+        return;
+      }
 
-    for (int n = 0; n < file.frames(); n++) {
-      bin_x.push_back(time_axis[n]);
+      job = *irs_job;
 
-      bin_l_y.push_back(left_mag[n]);
-      bin_r_y.push_back(right_mag[n]);
+      irs_job.reset();
+    }
 
-      if (bin_x.size() == bin_size) {
-        const auto& [min, max] = std::ranges::minmax_element(bin_l_y);
+    const auto& info = load_irs_info(job, stoken);
 
-        t.push_back(bin_x[min - bin_l_y.begin()]);
-        t.push_back(bin_x[max - bin_l_y.begin()]);
+    // the fftw plan has to be destroyed in the main thread. This callback does not depend on this object being alive
 
-        l.push_back(*min);
-        l.push_back(*max);
+    Glib::signal_idle().connect_once([job] { destroy_irs_job(job); });
 
-        const auto& [minr, maxr] = std::ranges::minmax_element(bin_r_y);
+    if (stoken.stop_requested()) {
+      return;
+    }
 
-        r.push_back(*minr);
-        r.push_back(*maxr);
+    std::scoped_lock<std::mutex> lock(lock_guard_irs_info);
 
-        bin_x.resize(0);
-        bin_l_y.resize(0);
-        bin_r_y.resize(0);
-      }
+    if (info == nullptr) {
+      connections.push_back(Glib::signal_idle().connect([=, this]() {
+        show_irs_failure();
+
+        return false;
+      }));
+
+      continue;
     }
 
-    time_axis = t;
-    left_mag = l;
-    right_mag = r;
-  }
+    if (irs_info_cache.size() >= 8U) {
+      irs_info_cache.erase(irs_info_cache.begin());
+    }
 
-  // ensure that the fft can be computed
+    irs_info_cache[job.path] = info;
 
-  if (time_axis.size() % 2U != 0U) {
-    time_axis.push_back(static_cast<float>(time_axis.size() - 1U) * dt);
-  }
+    // there is no point in showing this file if another one was selected while we were busy with it
 
-  if (left_mag.size() % 2U != 0U) {
-    left_mag.push_back(0.0F);
-  }
+    if (irs_job.has_value()) {
+      continue;
+    }
+
+    connections.push_back(Glib::signal_idle().connect([=, this]() {
+      show_irs_info(job.path, info);
 
-  if (right_mag.size() % 2U != 0U) {
-    right_mag.push_back(0.0F);
+      return false;
+    }));
   }
+}
 
-  time_axis.shrink_to_fit();
-  left_mag.shrink_to_fit();
-  right_mag.shrink_to_fit();
+auto ConvolverUi::load_irs_info(const IrsJob& job, const std::stop_token& stoken) -> std::shared_ptr<IrsInfo> {
+  util::debug(log_tag + "reading the impulse file: " + job.path);
 
-  // find min and max values
+  SndfileHandle file = SndfileHandle(job.path.c_str());
 
-  const auto& min_left = std::ranges::min(left_mag);
-  const auto& max_left = std::ranges::max(left_mag);
+  // the plan was created for the number of frames the file had when it was selected
 
-  const auto& min_right = std::ranges::min(right_mag);
-  const auto& max_right = std::ranges::max(right_mag);
+  if (file.channels() != 2 || file.frames() != job.frames) {
+    return nullptr;
+  }
 
-  // rescaling between 0 and 1
+  std::vector<float> kernel(file.channels() * file.frames());
 
-  for (size_t n = 0U; n < left_mag.size(); n++) {
-    left_mag[n] = (left_mag[n] - min_left) / (max_left - min_left);
-    right_mag[n] = (right_mag[n] - min_right) / (max_right - min_right);
-  }
+  file.readf(kernel.data(), file.frames());
 
-  // updating interface with ir file info
+  auto info = std::make_shared<IrsInfo>();
 
-  connections.push_back(Glib::signal_idle().connect([=, this]() {
-    label_sampling_rate->set_text(Glib::ustring::format(file.samplerate()) + " Hz");
-    label_samples->set_text(Glib::ustring::format(file.frames()));
+  std::error_code ec;
 
-    label_duration->set_text(level_to_localized_string(duration, 3) + " s");
+  info->mtime = std::filesystem::last_write_time(job.path, ec);
+  info->rate = file.samplerate();
+  info->frames = job.frames;
+  info->duration = (static_cast<float>(job.frames) - 1.0F) / static_cast<float>(info->rate);
 
-    const auto& fpath = std::filesystem::path{path.raw()};
+  std::vector<float> left(job.frames);
+  std::vector<float> right(job.frames);
 
-    label_file_name->set_text(fpath.stem().c_str());
+  for (int n = 0; n < job.frames; n++) {
+    left[n] = kernel[2 * n];
 
-    plot_waveform();
+    right[n] = kernel[2 * n + 1];
+  }
 
-    return false;
-  }));
-}
+  build_minmax_pyramid(left, info->left_min, info->left_max);
+  build_minmax_pyramid(right, info->right_min, info->right_max);
 
-void ConvolverUi::get_irs_spectrum(const int& rate) {
-  if (left_mag.empty() || right_mag.empty()) {
-    return;
+  if (stoken.stop_requested()) {
+    return info;
   }
 
   util::debug(log_tag + "calculating the impulse fft...");
 
-  left_spectrum.resize(left_mag.size() / 2U + 1U);
-  right_spectrum.resize(right_mag.size() / 2U + 1U);
+  // https://en.wikipedia.org/wiki/Hann_function
 
-  auto real_input = left_mag;
+  std::vector<float> window(job.frames, 1.0F);
 
-  for (uint n = 0U; n < real_input.size(); n++) {
-    // https://en.wikipedia.org/wiki/Hann_function
+  if (job.frames > 1) {
+    for (int n = 0; n < job.frames; n++) {
+      window[n] = 0.5F * (1.0F - std::cos(2.0F * std::numbers::pi_v<float> * static_cast<float>(n) /
+                                          static_cast<float>(job.frames - 1)));
+    }
+  }
 
-    const float w = 0.5F * (1.0F - std::cos(2.0F * std::numbers::pi_v<float> * static_cast<float>(n) /
-                                            static_cast<float>(real_input.size() - 1U)));
+  const auto& n_bins = static_cast<size_t>(job.frames / 2 + 1);
 
-    real_input[n] *= w;
-  }
+  auto power_spectrum = [&](const std::vector<float>& samples, std::vector<float>& output) {
+    for (int n = 0; n < job.frames; n++) {
+      job.real_input[n] = samples[n] * window[n];
+    }
+
+    fftwf_execute(job.plan);
+
+    output.resize(n_bins);
+
+    for (size_t i = 0U; i < n_bins; i++) {
+      const float sqr =
+          job.complex_output[i][0] * job.complex_output[i][0] + job.complex_output[i][1] * job.complex_output[i][1];
 
-  auto* complex_output = fftwf_alloc_complex(real_input.size());
+      output[i] = sqr / static_cast<float>(n_bins * n_bins);
+    }
+  };
 
-  auto* plan =
-      fftwf_plan_dft_r2c_1d(static_cast<int>(real_input.size()), real_input.data(), complex_output, FFTW_ESTIMATE);
+  power_spectrum(left, info->left_power);
+  power_spectrum(right, info->right_power);
 
-  fftwf_execute(plan);
+  return info;
+}
 
-  for (uint i = 0U; i < left_spectrum.size(); i++) {
-    float sqr = complex_output[i][0] * complex_output[i][0] + complex_output[i][1] * complex_output[i][1];
+void ConvolverUi::destroy_irs_job(const IrsJob& job) {
+  if (job.plan != nullptr) {
+    fftwf_destroy_plan(job.plan);
+  }
 
-    sqr /= static_cast<float>(left_spectrum.size() * left_spectrum.size());
+  if (job.real_input != nullptr) {
+    fftwf_free(job.real_input);
+  }
 
-    left_spectrum[i] = sqr;
+  if (job.complex_output != nullptr) {
+    fftwf_free(job.complex_output);
   }
+}
+
+void ConvolverUi::build_minmax_pyramid(const std::vector<float>& samples,
+                                       std::vector<std::vector<float>>& min,
+                                       std::vector<std::vector<float>>& max) {
+  min.clear();
+  max.clear();
+
+  min.push_back(samples);
+  max.push_back(samples);
 
-  // right channel fft
+  // each level is built from the previous one. The total cost is linear in the number of samples
 
-  real_input = right_mag;
+  while (min.back().size() > 1U) {
+    const auto& prev_size = min.back().size();
 
-  for (uint n = 0U; n < real_input.size(); n++) {
-    // https://en.wikipedia.org/wiki/Hann_function
+    std::vector<float> level_min((prev_size + 1U) / 2U);
+    std::vector<float> level_max((prev_size + 1U) / 2U);
 
-    const float w = 0.5F * (1.0F - std::cos(2.0F * std::numbers::pi_v<float> * static_cast<float>(n) /
-                                            static_cast<float>(real_input.size() - 1U)));
+    for (size_t n = 0U; n < level_min.size(); n++) {
+      const auto& a = 2U * n;
+      const auto b = std::min(2U * n + 1U, prev_size - 1U);
+
+      level_min[n] = std::min(min.back()[a], min.back()[b]);
+      level_max[n] = std::max(max.back()[a], max.back()[b]);
+    }
 
-    real_input[n] *= w;
+    min.push_back(std::move(level_min));
+    max.push_back(std::move(level_max));
   }
+}
+
+void ConvolverUi::decimate_waveform(const int& n_points) {
+  const auto& info = *irs_info;
 
-  fftwf_execute(plan);
+  const float dt = 1.0F / static_cast<float>(info.rate);
 
-  for (uint i = 0U; i < right_spectrum.size(); i++) {
-    float sqr = complex_output[i][0] * complex_output[i][0] + complex_output[i][1] * complex_output[i][1];
+  // the first pyramid level with at most n_points blocks. Each block becomes a min/max pair in the plot
 
-    sqr /= static_cast<float>(right_spectrum.size() * right_spectrum.size());
+  size_t level = 0U;
 
-    right_spectrum[i] = sqr;
+  while (level + 1U < info.left_min.size() && info.left_min[level].size() > static_cast<size_t>(n_points)) {
+    level++;
   }
 
-  // cleaning
+  const auto& left_min = info.left_min[level];
+  const auto& left_max = info.left_max[level];
+  const auto& right_min = info.right_min[level];
+  const auto& right_max = info.right_max[level];
 
-  fftwf_destroy_plan(plan);
+  if (level == 0U) {
+    time_axis.resize(left_min.size());
+    left_mag.resize(left_min.size());
+    right_mag.resize(left_min.size());
 
-  if (complex_output != nullptr) {
-    fftwf_free(complex_output);
+    for (size_t n = 0U; n < left_min.size(); n++) {
+      time_axis[n] = static_cast<float>(n) * dt;
+
+      left_mag[n] = left_min[n];
+      right_mag[n] = right_min[n];
+    }
+  } else {
+    const float block_duration = static_cast<float>(1U << level) * dt;
+
+    time_axis.resize(2U * left_min.size());
+    left_mag.resize(2U * left_min.size());
+    right_mag.resize(2U * left_min.size());
+
+    for (size_t n = 0U; n < left_min.size(); n++) {
+      time_axis[2U * n] = static_cast<float>(n) * block_duration;
+      time_axis[2U * n + 1U] = (static_cast<float>(n) + 0.5F) * block_duration;
+
+      left_mag[2U * n] = left_min[n];
+      left_mag[2U * n + 1U] = left_max[n];
+
+      right_mag[2U * n] = right_min[n];
+      right_mag[2U * n + 1U] = right_max[n];
+    }
   }
 
-  // initializing the frequency axis
+  // the top of the pyramid has the global min and max values
 
-  freq_axis.resize(left_spectrum.size());
+  const auto& min_left = info.left_min.back()[0];
+  const auto& max_left = info.left_max.back()[0];
 
-  for (uint n = 0U; n < left_spectrum.size(); n++) {
-    freq_axis[n] = 0.5F * static_cast<float>(rate) * static_cast<float>(n) / static_cast<float>(left_spectrum.size());
+  const auto& min_right = info.right_min.back()[0];
+  const auto& max_right = info.right_max.back()[0];
+
+  // rescaling between 0 and 1
+
+  for (size_t n = 0U; n < left_mag.size(); n++) {
+    left_mag[n] = (left_mag[n] - min_left) / (max_left - min_left);
+    right_mag[n] = (right_mag[n] - min_right) / (max_right - min_right);
   }
+}
+
+void ConvolverUi::bin_spectrum(const int& n_points) {
+  const auto& info = *irs_info;
 
   // initializing the logarithmic frequency axis
 
-  const auto& log_axis =
-      util::logspace(std::log10(20.0F), std::log10(22000.0F), spectrum_settings->get_int("n-points"));
-  // auto log_axis = util::linspace(20.0F, 22000.0F, spectrum_settings->get_int("n-points"));
+  freq_axis = util::logspace(std::log10(20.0F), std::log10(22000.0F), n_points);
+
+  left_spectrum.resize(freq_axis.size());
+  right_spectrum.resize(freq_axis.size());
 
-  std::vector<float> l(log_axis.size());
-  std::vector<float> r(log_axis.size());
-  std::vector<uint> bin_count(log_axis.size());
+  std::vector<uint> bin_count(freq_axis.size());
 
-  std::ranges::fill(l, 0.0F);
-  std::ranges::fill(r, 0.0F);
+  std::ranges::fill(left_spectrum, 0.0F);
+  std::ranges::fill(right_spectrum, 0.0F);
   std::ranges::fill(bin_count, 0U);
 
-  // reducing the amount of data we have to plot and converting the frequency axis to the logarithimic scale
+  /*
+    Reducing the amount of data we have to plot and converting the frequency axis to the logarithimic scale. The fft
+    bins and the plot points are both sorted by frequency. So the point each bin belongs to is found while walking the
+    bins and the whole mapping costs a single pass over the spectrum.
+  */
 
-  for (size_t j = 0U; j < freq_axis.size(); j++) {
-    for (size_t n = 0U; n < log_axis.size(); n++) {
-      if (n > 0U) {
-        if (freq_axis[j] <= log_axis[n] && freq_axis[j] > log_axis[n - 1U]) {
-          l[n] += left_spectrum[j];
-          r[n] += right_spectrum[j];
+  const auto& n_bins = info.left_power.size();
 
-          bin_count[n]++;
-        }
-      } else {
-        if (freq_axis[j] <= log_axis[n]) {
-          l[n] += left_spectrum[j];
-          r[n] += right_spectrum[j];
+  size_t n = 0U;
 
-          bin_count[n]++;
-        }
-      }
+  for (size_t j = 0U; j < n_bins; j++) {
+    const float freq = 0.5F * static_cast<float>(info.rate) * static_cast<float>(j) / static_cast<float>(n_bins);
+
+    while (n < freq_axis.size() && freq > freq_axis[n]) {
+      n++;
+    }
+
+    if (n == freq_axis.size()) {
+      break;
     }
+
+    left_spectrum[n] += info.left_power[j];
+    right_spectrum[n] += info.right_power[j];
+
+    bin_count[n]++;
   }
 
   // fillint empty bins with their neighbors value
 
-  for (size_t n = 0U; n < bin_count.size(); n++) {
-    if (bin_count[n] == 0U && n > 0U) {
-      l[n] = l[n - 1U];
-      r[n] = r[n - 1U];
+  for (size_t m = 1U; m < bin_count.size(); m++) {
+    if (bin_count[m] == 0U) {
+      left_spectrum[m] = left_spectrum[m - 1U];
+      right_spectrum[m] = right_spectrum[m - 1U];
     }
   }
 
-  freq_axis = log_axis;
-  left_spectrum = l;
-  right_spectrum = r;
-
   // find min and max values
 
-  const auto& fft_min_left = std::ranges::min(left_spectrum);
-  const auto& fft_max_left = std::ranges::max(left_spectrum);
-
-  const auto& fft_min_right = std::ranges::min(right_spectrum);
-  const auto& fft_max_right = std::ranges::max(right_spectrum);
+  const auto& [fft_min_left, fft_max_left] = std::ranges::minmax(left_spectrum);
+  const auto& [fft_min_right, fft_max_right] = std::ranges::minmax(right_spectrum);
 
   // rescaling between 0 and 1
 
-  for (uint n = 0; n < left_spectrum.size(); n++) {
-    left_spectrum[n] = (left_spectrum[n] - fft_min_left) / (fft_max_left - fft_min_left);
-    right_spectrum[n] = (right_spectrum[n] - fft_min_right) / (fft_max_right - fft_min_right);
+  for (size_t m = 0U; m < left_spectrum.size(); m++) {
+    left_spectrum[m] = (left_spectrum[m] - fft_min_left) / (fft_max_left - fft_min_left);
+    right_spectrum[m] = (right_spectrum[m] - fft_min_right) / (fft_max_right - fft_min_right);
   }
+}
 
-  connections.push_back(Glib::signal_idle().connect([=, this]() {
-    plot_fft();
+void ConvolverUi::show_irs_info(const std::string& path, const std::shared_ptr<const IrsInfo>& info) {
+  irs_info = info;
 
-    return false;
-  }));
+  // updating interface with ir file info
+
+  label_sampling_rate->set_text(Glib::ustring::format(info->rate) + " Hz");
+  label_samples->set_text(Glib::ustring::format(info->frames));
+
+  label_duration->set_text(level_to_localized_string(info->duration, 3) + " s");
+
+  label_file_name->set_text(std::filesystem::path{path}.stem().c_str());
+
+  const auto& n_points = spectrum_settings->get_int("n-points");
+
+  decimate_waveform(n_points);
+
+  bin_spectrum(n_points);
+
+  (show_fft->get_active()) ? plot_fft() : plot_waveform();
+}
+
+void ConvolverUi::show_irs_failure() {
+  // warning user that there is a problem
+
+  label_sampling_rate->set_text(_("Failed"));
+  label_samples->set_text(_("Failed"));
+
+  label_duration->set_text(_("Failed"));
+
+  label_file_name->set_text(_("Could Not Load The Impulse File"));
 }
 
 void ConvolverUi::plot_waveform() {
@@ -0,0 +1,251 @@
+/*
+ *  Copyright © 2017-2022 Wellington Wallace
+ *
+ *  This file is part of EasyEffects.
+ *
+ *  EasyEffects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  EasyEffects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with EasyEffects.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "core.hpp"
+
+Core::Core()
+    : settings(Gio::Settings::create("com.github.wwmm.easyeffects")),
+      soe_settings(Gio::Settings::create("com.github.wwmm.easyeffects.streamoutputs")),
+      sie_settings(Gio::Settings::create("com.github.wwmm.easyeffects.streaminputs")) {
+  pm = std::make_unique<PipeManager>();
+  soe = std::make_unique<StreamOutputEffects>(pm.get());
+  sie = std::make_unique<StreamInputEffects>(pm.get());
+
+  presets_manager = std::make_unique<PresetsManager>();
+
+  presets_manager->preset_transition = [&](const PresetType& preset_type, const std::function<void()>& apply) {
+    switch (preset_type) {
+      case PresetType::output:
+        soe->run_preset_transition(apply);
+        break;
+      case PresetType::input:
+        sie->run_preset_transition(apply);
+        break;
+    }
+  };
+
+  pm->new_default_sink.connect([&](const NodeInfo node) {
+    util::debug("new default output device: " + node.name);
+
+    if (soe_settings->get_boolean("use-default-output-device")) {
+      /*
+        Depending on the hardware headphones can cause a node recreation here the id and the name are kept.
+        So we clear the key to force the callbacks to be called
+      */
+
+      soe_settings->set_string("output-device", "");
+      soe_settings->set_string("output-device", node.name);
+    }
+  });
+
+  pm->new_default_source.connect([&](const NodeInfo node) {
+    util::debug("new default input device: " + node.name);
+
+    if (sie_settings->get_boolean("use-default-input-device")) {
+      /*
+        Depending on the hardware microphones can cause a node recreation hwere the id and the name are kept.
+        So we clear the key to force the callbacks to be called
+      */
+
+      sie_settings->set_string("input-device", "");
+      sie_settings->set_string("input-device", node.name);
+    }
+  });
+
+  pm->device_input_route_changed.connect([&](const DeviceInfo device) {
+    if (device.input_route_available == SPA_PARAM_AVAILABILITY_no) {
+      return;
+    }
+
+    util::debug(log_tag + "device " + device.name + " has changed its input route to: " + device.input_route_name);
+
+    NodeInfo target_node;
+
+    for (const auto& [ts, node] : pm->node_map) {
+      if (node.device_id == device.id && node.media_class == pm->media_class_source) {
+        target_node = node;
+
+        break;
+      }
+    }
+
+    if (target_node.id != SPA_ID_INVALID) {
+      if (target_node.name.c_str() == sie_settings->get_string("input-device")) {
+        presets_manager->autoload(PresetType::input, target_node.name, device.input_route_name);
+      } else {
+        util::debug(log_tag + "input autoloading: the target node name does not match the input device name");
+      }
+    } else {
+      util::debug(log_tag + "input autoloading: could not find the target node");
+    }
+  });
+
+  pm->device_output_route_changed.connect([&](const DeviceInfo device) {
+    if (device.output_route_available == SPA_PARAM_AVAILABILITY_no) {
+      return;
+    }
+
+    util::debug(log_tag + "device " + device.name + " has changed its output route to: " + device.output_route_name);
+
+    NodeInfo target_node;
+
+    for (const auto& [ts, node] : pm->node_map) {
+      if (node.device_id == device.id && node.media_class == pm->media_class_sink) {
+        target_node = node;
+
+        break;
+      }
+    }
+
+    if (target_node.id != SPA_ID_INVALID) {
+      if (target_node.name.c_str() == soe_settings->get_string("output-device")) {
+        presets_manager->autoload(PresetType::output, target_node.name, device.output_route_name);
+      } else {
+        util::debug(log_tag + "output autoloading: the target node name does not match the output device name");
+      }
+    } else {
+      util::debug(log_tag + "output autoloading: could not find the target node");
+    }
+  });
+
+  soe_settings->signal_changed("output-device").connect([&, this](const auto& key) {
+    const auto name = soe_settings->get_string(key).raw();
+
+    if (name.empty()) {
+      return;
+    }
+
+    uint device_id = SPA_ID_INVALID;
+
+    for (const auto& [ts, node] : pm->node_map) {
+      if (node.name == name) {
+        device_id = node.device_id;
+
+        break;
+      }
+    }
+
+    if (device_id != SPA_ID_INVALID) {
+      for (const auto& device : pm->list_devices) {
+        if (device.id == device_id) {
+          presets_manager->autoload(PresetType::output, name, device.output_route_name);
+
+          break;
+        }
+      }
+    }
+  });
+
+  sie_settings->signal_changed("input-device").connect([&, this](const auto& key) {
+    const auto name = sie_settings->get_string(key).raw();
+
+    if (name.empty()) {
+      return;
+    }
+
+    uint device_id = SPA_ID_INVALID;
+
+    for (const auto& [ts, node] : pm->node_map) {
+      if (node.name == name) {
+        device_id = node.device_id;
+
+        break;
+      }
+    }
+
+    if (device_id != SPA_ID_INVALID) {
+      for (const auto& device : pm->list_devices) {
+        if (device.id == device_id) {
+          presets_manager->autoload(PresetType::input, name, device.input_route_name);
+
+          break;
+        }
+      }
+    }
+  });
+
+  settings->signal_changed("bypass").connect([=, this](const auto& key) { update_bypass_state(key); });
+
+  update_bypass_state("bypass");
+}
+
+Core::~Core() {
+  util::debug(log_tag + "destroyed");
+}
+
+void Core::load_preset(const std::string& name) {
+  if (presets_manager->preset_file_exists(PresetType::input, name)) {
+    presets_manager->load_preset_file(PresetType::input, name);
+  }
+
+  if (presets_manager->preset_file_exists(PresetType::output, name)) {
+    presets_manager->load_preset_file(PresetType::output, name);
+  }
+}
+
+void Core::export_control_interface(const Glib::RefPtr<Gio::DBus::Connection>& connection) {
+  if (connection == nullptr) {
+    util::warning(log_tag + "there is no D-Bus connection. The control interface will not be available");
+
+    return;
+  }
+
+  control_interface = std::make_unique<ControlInterface>(connection, soe.get(), sie.get());
+}
+
+auto Core::claim_bus_name(const Glib::RefPtr<Gio::DBus::Connection>& connection) -> bool {
+  if (connection == nullptr) {
+    util::warning(log_tag + "there is no D-Bus connection. Can not check if another instance is running");
+
+    return true;
+  }
+
+  // flag DBUS_NAME_FLAG_DO_NOT_QUEUE and the replies DBUS_REQUEST_NAME_REPLY_PRIMARY_OWNER/ALREADY_OWNER
+
+  constexpr guint32 do_not_queue = 4U;
+  constexpr guint32 primary_owner = 1U;
+  constexpr guint32 already_owner = 4U;
+
+  try {
+    const auto& reply = connection->call_sync(
+        "/org/freedesktop/DBus", "org.freedesktop.DBus", "RequestName",
+        Glib::VariantContainerBase::create_tuple(
+            {Glib::Variant<Glib::ustring>::create(bus_name), Glib::Variant<guint32>::create(do_not_queue)}),
+        "org.freedesktop.DBus");
+
+    Glib::Variant<guint32> result;
+
+    reply.get_child(result, 0);
+
+    return result.get() == primary_owner || result.get() == already_owner;
+  } catch (const Glib::Error& e) {
+    util::warning(log_tag + "could not request the name " + bus_name + ": " + e.what());
+
+    return true;
+  }
+}
+
+void Core::update_bypass_state(const Glib::ustring& key) {
+  const auto& state = settings->get_boolean(key);
+
+  soe->set_bypass(state);
+  sie->set_bypass(state);
+
+  util::info(log_tag + ((state) ? "enabling" : "disabling") + " global bypass");
+}
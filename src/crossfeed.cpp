@@ -29,13 +29,13 @@ Crossfeed::Crossfeed(const std::string& tag,
   bs2b.set_level_feed(10 * static_cast<int>(settings->get_double("feed")));
 
   settings->signal_changed("fcut").connect([=, this](const auto& key) {
-    std::scoped_lock<std::mutex> lock(data_mutex);
+    std::scoped_lock<std::recursive_mutex> lock(data_mutex);
 
     bs2b.set_level_fcut(settings->get_int(key));
   });
 
   settings->signal_changed("feed").connect([=, this](const auto& key) {
-    std::scoped_lock<std::mutex> lock(data_mutex);
+    std::scoped_lock<std::recursive_mutex> lock(data_mutex);
 
     bs2b.set_level_feed(10 * settings->get_double(key));
   });
@@ -52,7 +52,7 @@ Crossfeed::~Crossfeed() {
 }
 
 void Crossfeed::setup() {
-  std::scoped_lock<std::mutex> lock(data_mutex);
+  std::scoped_lock<std::recursive_mutex> lock(data_mutex);
 
   bs2b.set_srate(rate);
 
@@ -63,7 +63,7 @@ void Crossfeed::process(std::span<float>& left_in,
                         std::span<float>& right_in,
                         std::span<float>& left_out,
                         std::span<float>& right_out) {
-  std::scoped_lock<std::mutex> lock(data_mutex);
+  std::scoped_lock<std::recursive_mutex> lock(data_mutex);
 
   if (bypass) {
     std::copy(left_in.begin(), left_in.end(), left_out.begin());
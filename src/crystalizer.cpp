@@ -23,16 +23,13 @@ Crystalizer::Crystalizer(const std::string& tag,
                          const std::string& schema,
                          const std::string& schema_path,
                          PipeManager* pipe_manager)
-    : PluginBase(tag, plugin_name::crystalizer, schema, schema_path, pipe_manager) {
-  for (uint n = 0U; n < nbands; n++) {
-    filters.at(n) = std::make_unique<FirFilterBandpass>(log_tag + name + " band" + std::to_string(n));
-  }
-
+    : PluginBase(tag, plugin_name::crystalizer, schema, schema_path, pipe_manager),
+      filter_bank(std::make_unique<FirFilterBank>(log_tag + name + " filter bank: ")) {
   std::ranges::fill(band_mute, false);
   std::ranges::fill(band_bypass, false);
   std::ranges::fill(band_intensity, 1.0F);
-  std::ranges::fill(band_last_L, 0.0F);
-  std::ranges::fill(band_last_R, 0.0F);
+  std::ranges::fill(band_history_L, std::array<float, 2U>{0.0F, 0.0F});
+  std::ranges::fill(band_history_R, std::array<float, 2U>{0.0F, 0.0F});
 
   frequencies[0] = 20.0F;
   frequencies[1] = 520.0F;
@@ -74,9 +71,9 @@ void Crystalizer::setup() {
   filters_are_ready = false;
 
   /*
-    As zita uses fftw we have to be careful when reinitializing it. The thread that creates the fftw plan has to be the
-    same that destroys it. Otherwise segmentation faults can happen. As we do not want to do this initializing in the
-    plugin realtime thread we send it to the main thread through Glib::signal_idle().connect_once
+    As the filter bank uses fftw we have to be careful when reinitializing it. The thread that creates the fftw plan has
+    to be the same that destroys it. Otherwise segmentation faults can happen. As we do not want to do this
+    initializing in the plugin realtime thread we send it to the main thread through Glib::signal_idle().connect_once
   */
 
   Glib::signal_idle().connect_once([&, this] {
@@ -93,7 +90,9 @@ void Crystalizer::setup() {
     util::debug(log_tag + name + " blocksize: " + std::to_string(blocksize));
 
     notify_latency = true;
-    do_first_rotation = true;
+
+    std::ranges::fill(band_history_L, std::array<float, 2U>{0.0F, 0.0F});
+    std::ranges::fill(band_history_R, std::array<float, 2U>{0.0F, 0.0F});
 
     latency_n_frames = 1U;  // the second derivative forces us to delay at least one sample
 
@@ -106,22 +105,15 @@ void Crystalizer::setup() {
     for (uint n = 0U; n < nbands; n++) {
       band_data_L.at(n).resize(blocksize);
       band_data_R.at(n).resize(blocksize);
-
-      band_second_derivative_L.at(n).resize(blocksize);
-      band_second_derivative_R.at(n).resize(blocksize);
     }
 
-    for (uint n = 0U; n < nbands; n++) {
-      filters.at(n)->set_n_samples(blocksize);
-      filters.at(n)->set_rate(rate);
-
-      filters.at(n)->set_min_frequency(frequencies.at(n));
-      filters.at(n)->set_max_frequency(frequencies.at(n + 1U));
+    filter_bank->set_n_samples(blocksize);
+    filter_bank->set_rate(rate);
+    filter_bank->set_frequencies(frequencies);
 
-      filters.at(n)->setup();
-    }
+    filter_bank->setup();
 
-    std::scoped_lock<std::mutex> lock(data_mutex);
+    std::scoped_lock<std::recursive_mutex> lock(data_mutex);
 
     filters_are_ready = true;
   });
@@ -131,7 +123,7 @@ void Crystalizer::process(std::span<float>& left_in,
                           std::span<float>& right_in,
                           std::span<float>& left_out,
                           std::span<float>& right_out) {
-  std::scoped_lock<std::mutex> lock(data_mutex);
+  std::scoped_lock<std::recursive_mutex> lock(data_mutex);
 
   if (bypass || !filters_are_ready) {
     std::copy(left_in.begin(), left_in.end(), left_out.begin());
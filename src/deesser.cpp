@@ -106,14 +106,18 @@ void Deesser::process(std::span<float>& left_in,
       detected_port_value = static_cast<double>(lv2_wrapper->get_control_port_value("detected"));
       compression_port_value = static_cast<double>(lv2_wrapper->get_control_port_value("compression"));
 
-      Glib::signal_idle().connect_once([=, this] {
-        detected.emit(detected_port_value);
-        compression.emit(compression_port_value);
-      });
-
       notify();
 
       notification_dt = 0.0F;
     }
   }
 }
+
+void Deesser::emit_meters() {
+  detected.emit(detected_port_value.load());
+  compression.emit(compression_port_value.load());
+}
+
+auto Deesser::set_realtime_parameter(const std::string& key, const Glib::VariantBase& value) -> bool {
+  return PluginBase::set_realtime_parameter(key, value) || lv2_wrapper->set_bound_key(settings, key, value);
+}
@@ -119,3 +119,7 @@ void Delay::process(std::span<float>& left_in,
     }
   }
 }
+
+auto Delay::set_realtime_parameter(const std::string& key, const Glib::VariantBase& value) -> bool {
+  return PluginBase::set_realtime_parameter(key, value) || lv2_wrapper->set_bound_key(settings, key, value);
+}
@@ -0,0 +1,296 @@
+/*
+ *  Copyright © 2017-2022 Wellington Wallace
+ *
+ *  This file is part of EasyEffects.
+ *
+ *  EasyEffects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  EasyEffects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with EasyEffects.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "delay_estimator.hpp"
+
+namespace {
+
+// the correlation peak has to stand out this much from the average correlation to be trusted
+
+constexpr float min_peak_ratio = 8.0F;
+
+}  // namespace
+
+DelayEstimator::DelayEstimator(std::string tag) : log_tag(std::move(tag)) {}
+
+DelayEstimator::~DelayEstimator() {
+  ready = false;
+
+  stop_worker();
+
+  free_fftw();
+}
+
+void DelayEstimator::set_rate(const uint& value) {
+  rate = value;
+}
+
+void DelayEstimator::set_max_delay(const float& value) {
+  max_delay = value;
+}
+
+auto DelayEstimator::is_ready() const -> bool {
+  return ready;
+}
+
+auto DelayEstimator::get_delay() const -> int {
+  return delay.load(std::memory_order_relaxed);
+}
+
+void DelayEstimator::free_fftw() {
+  if (forward_plan != nullptr) {
+    fftwf_destroy_plan(forward_plan);
+  }
+
+  if (backward_plan != nullptr) {
+    fftwf_destroy_plan(backward_plan);
+  }
+
+  for (auto* p : {mic_time, reference_time}) {
+    if (p != nullptr) {
+      fftwf_free(p);
+    }
+  }
+
+  for (auto* p : {mic_freq, reference_freq}) {
+    if (p != nullptr) {
+      fftwf_free(p);
+    }
+  }
+
+  forward_plan = nullptr;
+  backward_plan = nullptr;
+  mic_time = nullptr;
+  reference_time = nullptr;
+  mic_freq = nullptr;
+  reference_freq = nullptr;
+}
+
+void DelayEstimator::setup() {
+  ready = false;
+
+  stop_worker();
+
+  free_fftw();
+
+  if (rate == 0U) {
+    return;
+  }
+
+  max_delay_frames = static_cast<uint>(max_delay * static_cast<float>(rate));
+
+  /*
+    The smallest power of two that holds one second of audio and four times the largest delay we are looking for. With
+    the default maximum delay of 0.5 s at 48 kHz it is 131072 samples, about 2.7 seconds.
+  */
+
+  window_size = 1U;
+
+  while (window_size < std::max(rate, 4U * max_delay_frames)) {
+    window_size *= 2U;
+  }
+
+  // the zero padding avoids the circular correlation wrapping the lags around
+
+  fft_size = 2U * window_size;
+  n_bins = fft_size / 2U + 1U;
+
+  capture_position = 0U;
+
+  delay = -1;
+
+  mic_capture.assign(window_size, 0.0F);
+  reference_capture.assign(window_size, 0.0F);
+  mic_analysis.assign(window_size, 0.0F);
+  reference_analysis.assign(window_size, 0.0F);
+
+  mic_time = fftwf_alloc_real(fft_size);
+  reference_time = fftwf_alloc_real(fft_size);
+  mic_freq = fftwf_alloc_complex(n_bins);
+  reference_freq = fftwf_alloc_complex(n_bins);
+
+  forward_plan = fftwf_plan_dft_r2c_1d(static_cast<int>(fft_size), mic_time, mic_freq, FFTW_ESTIMATE);
+  backward_plan = fftwf_plan_dft_c2r_1d(static_cast<int>(fft_size), mic_freq, mic_time, FFTW_ESTIMATE);
+
+  window_pending = false;
+
+  worker = std::jthread([this](const std::stop_token& stoken) { run_worker(stoken); });
+
+  util::debug(log_tag + "delay estimator window: " + std::to_string(window_size) +
+              ", max delay: " + std::to_string(max_delay_frames));
+
+  ready = true;
+}
+
+void DelayEstimator::process(std::span<const float> mic_left,
+                             std::span<const float> mic_right,
+                             std::span<const float> reference_left,
+                             std::span<const float> reference_right) {
+  if (!ready) {
+    return;
+  }
+
+  for (size_t n = 0U; n < mic_left.size(); n++) {
+    if (capture_position == window_size) {
+      // the worker is still busy with the previous window. The next one starts when it is done
+
+      if (window_pending) {
+        return;
+      }
+
+      std::swap(mic_capture, mic_analysis);
+      std::swap(reference_capture, reference_analysis);
+
+      capture_position = 0U;
+
+      window_pending = true;
+
+      window_pending.notify_one();
+    }
+
+    mic_capture[capture_position] = 0.5F * (mic_left[n] + mic_right[n]);
+    reference_capture[capture_position] = 0.5F * (reference_left[n] + reference_right[n]);
+
+    capture_position++;
+  }
+}
+
+void DelayEstimator::stop_worker() {
+  if (!worker.joinable()) {
+    return;
+  }
+
+  worker.request_stop();
+
+  // waking up the thread so it can see the stop request
+
+  window_pending = true;
+
+  window_pending.notify_one();
+
+  worker.join();
+
+  window_pending = false;
+}
+
+void DelayEstimator::run_worker(const std::stop_token& stoken) {
+  /*
+    A delay is only published after two consecutive windows agree on it within one millisecond. It also has to differ
+    from the published one by more than that. Otherwise the jitter of a sample or two between windows would be
+    published every time.
+  */
+
+  const int tolerance = std::max(1, static_cast<int>(rate / 1000U));
+
+  int previous = -1;
+
+  while (true) {
+    window_pending.wait(false);
+
+    if (stoken.stop_requested()) {
+      return;
+    }
+
+    const auto value = estimate();
+
+    const int current = delay.load(std::memory_order_relaxed);
+
+    if (value >= 0 && previous >= 0 && std::abs(value - previous) <= tolerance &&
+        (current < 0 || std::abs(value - current) > tolerance)) {
+      delay = value;
+
+      util::debug(log_tag + "estimated reference delay: " + std::to_string(value) + " frames");
+    }
+
+    previous = value;
+
+    window_pending = false;
+  }
+}
+
+auto DelayEstimator::estimate() -> int {
+  float mic_energy = 0.0F;
+  float reference_energy = 0.0F;
+
+  for (uint n = 0U; n < window_size; n++) {
+    mic_energy += mic_analysis[n] * mic_analysis[n];
+    reference_energy += reference_analysis[n] * reference_analysis[n];
+  }
+
+  // nothing can be measured while the reference is silent or the microphone does not pick it up
+
+  if (reference_energy < 1.0e-8F * static_cast<float>(window_size) ||
+      mic_energy < 1.0e-10F * static_cast<float>(window_size)) {
+    return -1;
+  }
+
+  std::copy(mic_analysis.begin(), mic_analysis.end(), mic_time);
+  std::copy(reference_analysis.begin(), reference_analysis.end(), reference_time);
+
+  std::fill(mic_time + window_size, mic_time + fft_size, 0.0F);
+  std::fill(reference_time + window_size, reference_time + fft_size, 0.0F);
+
+  fftwf_execute_dft_r2c(forward_plan, mic_time, mic_freq);
+  fftwf_execute_dft_r2c(forward_plan, reference_time, reference_freq);
+
+  /*
+    The phase transform keeps only the phase of the cross spectrum. The correlation of signals with a colored spectrum
+    like speech and music then becomes a sharp peak at the delay.
+  */
+
+  for (uint k = 0U; k < n_bins; k++) {
+    const float re = mic_freq[k][0] * reference_freq[k][0] + mic_freq[k][1] * reference_freq[k][1];
+    const float im = mic_freq[k][1] * reference_freq[k][0] - mic_freq[k][0] * reference_freq[k][1];
+
+    const float norm = 1.0F / (std::sqrt(re * re + im * im) + 1.0e-12F);
+
+    mic_freq[k][0] = re * norm;
+    mic_freq[k][1] = im * norm;
+  }
+
+  fftwf_execute(backward_plan);
+
+  // the microphone always lags behind the reference. So only the non negative lags are searched
+
+  const auto last_lag = std::min(max_delay_frames, window_size - 1U);
+
+  uint peak_lag = 0U;
+  float peak = 0.0F;
+  float sum = 0.0F;
+
+  for (uint n = 0U; n <= last_lag; n++) {
+    const auto v = std::fabs(mic_time[n]);
+
+    sum += v;
+
+    if (v > peak) {
+      peak = v;
+
+      peak_lag = n;
+    }
+  }
+
+  const float mean = sum / static_cast<float>(last_lag + 1U);
+
+  if (mean <= 0.0F || peak < min_peak_ratio * mean) {
+    return -1;
+  }
+
+  return static_cast<int>(peak_lag);
+}
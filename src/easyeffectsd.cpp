@@ -0,0 +1,92 @@
+/*
+ *  Copyright © 2017-2022 Wellington Wallace
+ *
+ *  This file is part of EasyEffects.
+ *
+ *  EasyEffects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  EasyEffects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with EasyEffects.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <glib-unix.h>
+#include <giomm.h>
+#include <glibmm/i18n.h>
+#include "config.h"
+#include "core.hpp"
+
+/*
+  Headless EasyEffects. It runs the same effects pipelines, presets and autoloading as the graphical application but
+  it does not link to GTK. It must not run together with the graphical application because both would create the
+  EasyEffects virtual devices. Both claim the same name on the session bus before creating the core (see
+  Core::claim_bus_name) and the one that starts last quits.
+*/
+
+auto sigterm(void* data) -> bool {
+  auto* const app = static_cast<Gio::Application*>(data);
+
+  app->quit();
+
+  return G_SOURCE_REMOVE;
+}
+
+auto main(int argc, char* argv[]) -> int {
+  try {
+    auto* bindtext_output = bindtextdomain(GETTEXT_PACKAGE, LOCALE_DIR);
+    bind_textdomain_codeset(GETTEXT_PACKAGE, "UTF-8");
+    textdomain(GETTEXT_PACKAGE);
+
+    if (bindtext_output == nullptr && errno == ENOMEM) {
+      util::warning("main: bindtextdomain: Not enough memory available!");
+
+      return errno;
+    }
+
+    Gio::init();
+
+    auto app = Gio::Application::create("com.github.wwmm.easyeffectsd", Gio::Application::Flags::NONE);
+
+    std::unique_ptr<Core> core;
+
+    app->signal_startup().connect([&]() {
+      util::debug("easyeffectsd: easyeffects version: " + std::string(VERSION));
+
+      if (!Core::claim_bus_name(app->get_dbus_connection())) {
+        util::warning("easyeffectsd: EasyEffects is already running. Quit it before starting easyeffectsd");
+
+        app->quit();
+
+        return;
+      }
+
+      core = std::make_unique<Core>();
+
+      core->export_control_interface(app->get_dbus_connection());
+
+      // there are no windows keeping the application alive
+
+      app->hold();
+    });
+
+    app->signal_activate().connect([]() {});
+
+    app->signal_shutdown().connect([&]() { core = nullptr; });
+
+    g_unix_signal_add(2, (GSourceFunc)sigterm, app.get());
+    g_unix_signal_add(15, (GSourceFunc)sigterm, app.get());
+
+    return app->run(argc, argv);
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << std::endl;
+
+    return EXIT_FAILURE;
+  }
+}
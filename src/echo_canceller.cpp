@@ -23,9 +23,12 @@ EchoCanceller::EchoCanceller(const std::string& tag,
                              const std::string& schema,
                              const std::string& schema_path,
                              PipeManager* pipe_manager)
-    : PluginBase(tag, plugin_name::echo_canceller, schema, schema_path, pipe_manager, true) {
+    : PluginBase(tag, plugin_name::echo_canceller, schema, schema_path, pipe_manager, true),
+      delay_estimator(std::make_unique<DelayEstimator>(log_tag + name + " ")) {
+  delay_estimator->set_max_delay(max_reference_delay);
+
   settings->signal_changed("frame-size").connect([=, this](const auto& key) {
-    std::scoped_lock<std::mutex> lock(data_mutex);
+    std::scoped_lock<std::recursive_mutex> lock(data_mutex);
 
     blocksize_ms = settings->get_int(key);
 
@@ -33,13 +36,77 @@ EchoCanceller::EchoCanceller(const std::string& tag,
   });
 
   settings->signal_changed("filter-length").connect([=, this](const auto& key) {
-    std::scoped_lock<std::mutex> lock(data_mutex);
+    std::scoped_lock<std::recursive_mutex> lock(data_mutex);
 
     filter_length_ms = settings->get_int(key);
 
     init_speex();
   });
 
+  settings->signal_changed("channel-mode").connect([=, this](const auto& key) {
+    std::scoped_lock<std::recursive_mutex> lock(data_mutex);
+
+    update_channel_mode();
+
+    init_speex();
+  });
+
+  settings->signal_changed("automatic-delay").connect([=, this](const auto& key) {
+    std::scoped_lock<std::recursive_mutex> lock(data_mutex);
+
+    automatic_delay = settings->get_boolean(key);
+  });
+
+  automatic_delay = settings->get_boolean("automatic-delay");
+
+  settings->signal_changed("enable-suppression").connect([=, this](const auto& key) {
+    std::scoped_lock<std::recursive_mutex> lock(data_mutex);
+
+    enable_suppression = settings->get_boolean(key);
+
+    update_preprocessor();
+  });
+
+  settings->signal_changed("residual-echo-suppression").connect([=, this](const auto& key) {
+    std::scoped_lock<std::recursive_mutex> lock(data_mutex);
+
+    residual_echo_suppression = settings->get_int(key);
+
+    update_preprocessor();
+  });
+
+  settings->signal_changed("noise-suppression").connect([=, this](const auto& key) {
+    std::scoped_lock<std::recursive_mutex> lock(data_mutex);
+
+    noise_suppression = settings->get_int(key);
+
+    update_preprocessor();
+  });
+
+  settings->signal_changed("enable-agc").connect([=, this](const auto& key) {
+    std::scoped_lock<std::recursive_mutex> lock(data_mutex);
+
+    enable_agc = settings->get_boolean(key);
+
+    update_preprocessor();
+  });
+
+  settings->signal_changed("enable-dereverb").connect([=, this](const auto& key) {
+    std::scoped_lock<std::recursive_mutex> lock(data_mutex);
+
+    enable_dereverb = settings->get_boolean(key);
+
+    update_preprocessor();
+  });
+
+  enable_suppression = settings->get_boolean("enable-suppression");
+  residual_echo_suppression = settings->get_int("residual-echo-suppression");
+  noise_suppression = settings->get_int("noise-suppression");
+  enable_agc = settings->get_boolean("enable-agc");
+  enable_dereverb = settings->get_boolean("enable-dereverb");
+
+  update_channel_mode();
+
   setup_input_output_gain();
 }
 
@@ -52,12 +119,10 @@ EchoCanceller::~EchoCanceller() {
 
   ready = false;
 
-  if (echo_state_L != nullptr) {
-    speex_echo_state_destroy(echo_state_L);
-  }
+  free_preprocessor();
 
-  if (echo_state_R != nullptr) {
-    speex_echo_state_destroy(echo_state_R);
+  if (echo_state != nullptr) {
+    speex_echo_state_destroy(echo_state);
   }
 
   data_mutex.unlock();
@@ -66,7 +131,7 @@ EchoCanceller::~EchoCanceller() {
 }
 
 void EchoCanceller::setup() {
-  std::scoped_lock<std::mutex> lock(data_mutex);
+  std::scoped_lock<std::recursive_mutex> lock(data_mutex);
 
   ready = false;
 
@@ -77,7 +142,23 @@ void EchoCanceller::setup() {
   deque_out_L.resize(0);
   deque_out_R.resize(0);
 
+  estimated_delay = -1;
+
   init_speex();
+
+  // the estimator creates fftw plans. This has to be done in the main thread
+
+  estimator_ready = false;
+
+  Glib::signal_idle().connect_once([=, this] {
+    delay_estimator->set_rate(rate);
+
+    delay_estimator->setup();
+
+    std::scoped_lock<std::recursive_mutex> lock(data_mutex);
+
+    estimator_ready = delay_estimator->is_ready();
+  });
 }
 
 void EchoCanceller::process(std::span<float>& left_in,
@@ -86,7 +167,7 @@ void EchoCanceller::process(std::span<float>& left_in,
                             std::span<float>& right_out,
                             std::span<float>& probe_left,
                             std::span<float>& probe_right) {
-  std::scoped_lock<std::mutex> lock(data_mutex);
+  std::scoped_lock<std::recursive_mutex> lock(data_mutex);
 
   if (bypass || !ready) {
     std::copy(left_in.begin(), left_in.end(), left_out.begin());
@@ -99,29 +180,59 @@ void EchoCanceller::process(std::span<float>& left_in,
     apply_gain(left_in, right_in, input_gain);
   }
 
+  if (estimator_ready) {
+    delay_estimator->process(left_in, right_in, probe_left, probe_right);
+
+    update_probe_delay();
+  }
+
+  const auto& delay_line_size = static_cast<uint>(probe_delay_L.size());
+
   for (size_t j = 0U; j < left_in.size(); j++) {
-    data_L.push_back(left_in[j] * (SHRT_MAX + 1));
-    data_R.push_back(right_in[j] * (SHRT_MAX + 1));
+    if (channel_mode == ChannelMode::stereo) {
+      data[2U * block_position] = left_in[j] * (SHRT_MAX + 1);
+      data[2U * block_position + 1U] = right_in[j] * (SHRT_MAX + 1);
+    } else {
+      data[block_position] = 0.5F * (left_in[j] + right_in[j]) * (SHRT_MAX + 1);
+    }
+
+    probe_delay_L[probe_delay_position] = probe_left[j];
+    probe_delay_R[probe_delay_position] = probe_right[j];
+
+    const auto& delayed = (probe_delay_position + delay_line_size - probe_delay) % delay_line_size;
+
+    probe[2U * block_position] = probe_delay_L[delayed] * (SHRT_MAX + 1);
+    probe[2U * block_position + 1U] = probe_delay_R[delayed] * (SHRT_MAX + 1);
+
+    probe_delay_position = (probe_delay_position + 1U) % delay_line_size;
+
+    block_position++;
 
-    probe_L.push_back(probe_left[j] * (SHRT_MAX + 1));
-    probe_R.push_back(probe_right[j] * (SHRT_MAX + 1));
+    if (block_position == blocksize) {
+      speex_echo_cancellation(echo_state, data.data(), probe.data(), filtered.data());
 
-    if (data_L.size() == blocksize) {
-      speex_echo_cancellation(echo_state_L, data_L.data(), probe_L.data(), filtered_L.data());
-      speex_echo_cancellation(echo_state_R, data_R.data(), probe_R.data(), filtered_R.data());
+      if (preprocessor_active) {
+        for (uint c = 0U; c < n_mic_channels; c++) {
+          for (uint n = 0U; n < blocksize; n++) {
+            preprocess_block[n] = filtered[n * n_mic_channels + c];
+          }
 
-      for (const auto& v : filtered_L) {
-        deque_out_L.push_back(static_cast<float>(v) * inv_short_max);
+          speex_preprocess_run(preprocess_states[c], preprocess_block.data());
+
+          for (uint n = 0U; n < blocksize; n++) {
+            filtered[n * n_mic_channels + c] = preprocess_block[n];
+          }
+        }
       }
 
-      for (const auto& v : filtered_R) {
-        deque_out_R.push_back(static_cast<float>(v) * inv_short_max);
+      for (uint n = 0U; n < blocksize; n++) {
+        const auto& idx = n * n_mic_channels;
+
+        deque_out_L.push_back(static_cast<float>(filtered[idx]) * inv_short_max);
+        deque_out_R.push_back(static_cast<float>(filtered[idx + n_mic_channels - 1U]) * inv_short_max);
       }
 
-      data_L.resize(0);
-      data_R.resize(0);
-      probe_L.resize(0);
-      probe_R.resize(0);
+      block_position = 0U;
     }
   }
 
@@ -203,46 +314,147 @@ void EchoCanceller::process(std::span<float>& left_in,
   }
 }
 
+void EchoCanceller::update_channel_mode() {
+  const auto mode = settings->get_string("channel-mode");
+
+  if (mode == "Mono Microphone") {
+    channel_mode = ChannelMode::mono_microphone;
+
+    n_mic_channels = 1U;
+  } else {
+    channel_mode = ChannelMode::stereo;
+
+    n_mic_channels = 2U;
+  }
+}
+
+void EchoCanceller::update_probe_delay() {
+  const auto& estimate = delay_estimator->get_delay();
+
+  if (estimate >= 0 && estimate != estimated_delay) {
+    estimated_delay = estimate;
+
+    const float delay_ms = 1000.0F * static_cast<float>(estimate) / static_cast<float>(rate);
+
+    Glib::signal_idle().connect_once([=, this] { reference_delay.emit(delay_ms); });
+  }
+
+  const auto& margin = static_cast<int>(delay_safety_margin * static_cast<float>(rate));
+
+  uint target = 0U;
+
+  if (automatic_delay && estimated_delay > margin) {
+    target = std::min(static_cast<uint>(estimated_delay - margin), static_cast<uint>(probe_delay_L.size()) - 1U);
+  }
+
+  if (target == probe_delay) {
+    return;
+  }
+
+  const auto& shift = std::abs(static_cast<int>(target) - static_cast<int>(probe_delay));
+
+  probe_delay = target;
+
+  /*
+    The adaptive filter follows a shift of a few samples by itself. It is only reset when the alignment moved by more
+    than one millisecond and the filter adapted to the previous alignment is useless.
+  */
+
+  if (shift > std::max(1, static_cast<int>(rate / 1000U))) {
+    speex_echo_state_reset(echo_state);
+  }
+
+  util::debug(log_tag + name + " probe delay: " + std::to_string(probe_delay) + " frames");
+}
+
 void EchoCanceller::init_speex() {
   if (n_samples == 0U || rate == 0U) {
     return;
   }
 
-  data_L.resize(0);
-  data_R.resize(0);
-  probe_L.resize(0);
-  probe_R.resize(0);
+  block_position = 0U;
 
   blocksize = 0.001F * blocksize_ms * rate;
 
   util::debug(log_tag + name + " blocksize: " + std::to_string(blocksize));
 
-  filtered_L.resize(blocksize);
-  filtered_R.resize(blocksize);
+  data.assign(n_mic_channels * blocksize, 0);
+  probe.assign(2U * blocksize, 0);
+  filtered.assign(n_mic_channels * blocksize, 0);
+
+  probe_delay_position = 0U;
+
+  probe_delay_L.assign(static_cast<size_t>(max_reference_delay * static_cast<float>(rate)) + 1U, 0.0F);
+  probe_delay_R.assign(probe_delay_L.size(), 0.0F);
+
+  probe_delay = std::min(probe_delay, static_cast<uint>(probe_delay_L.size()) - 1U);
 
   const uint filter_length = 0.001F * filter_length_ms * rate;
 
   util::debug(log_tag + name + " filter length: " + std::to_string(filter_length));
 
-  if (echo_state_L != nullptr) {
-    speex_echo_state_destroy(echo_state_L);
+  if (echo_state != nullptr) {
+    speex_echo_state_destroy(echo_state);
   }
 
-  echo_state_L = speex_echo_state_init(blocksize, filter_length);
+  echo_state = speex_echo_state_init_mc(static_cast<int>(blocksize), static_cast<int>(filter_length),
+                                        static_cast<int>(n_mic_channels), 2);
 
-  if (speex_echo_ctl(echo_state_L, SPEEX_ECHO_SET_SAMPLING_RATE, &rate) != 0) {
+  if (speex_echo_ctl(echo_state, SPEEX_ECHO_SET_SAMPLING_RATE, &rate) != 0) {
     util::warning(log_tag + name + "SPEEX_ECHO_SET_SAMPLING_RATE: unknown request");
   }
 
-  if (echo_state_R != nullptr) {
-    speex_echo_state_destroy(echo_state_R);
+  init_preprocessor();
+
+  ready = true;
+}
+
+void EchoCanceller::free_preprocessor() {
+  for (auto* state : preprocess_states) {
+    speex_preprocess_state_destroy(state);
   }
 
-  echo_state_R = speex_echo_state_init(blocksize, filter_length);
+  preprocess_states.clear();
+}
 
-  if (speex_echo_ctl(echo_state_R, SPEEX_ECHO_SET_SAMPLING_RATE, &rate) != 0) {
-    util::warning(log_tag + name + "SPEEX_ECHO_SET_SAMPLING_RATE: unknown request");
+void EchoCanceller::init_preprocessor() {
+  free_preprocessor();
+
+  preprocess_block.assign(blocksize, 0);
+
+  for (uint c = 0U; c < n_mic_channels; c++) {
+    auto* state = speex_preprocess_state_init(static_cast<int>(blocksize), static_cast<int>(rate));
+
+    /*
+      The residual echo estimate of a multichannel echo state only comes from its first microphone channel. Binding it
+      to the preprocessor of the right channel would suppress the right channel with the echo of the left one. So in
+      stereo mode there is no residual echo suppression and only the noise is removed.
+    */
+
+    if (n_mic_channels == 1U && speex_preprocess_ctl(state, SPEEX_PREPROCESS_SET_ECHO_STATE, echo_state) != 0) {
+      util::warning(log_tag + name + "SPEEX_PREPROCESS_SET_ECHO_STATE: unknown request");
+    }
+
+    preprocess_states.push_back(state);
   }
 
-  ready = true;
+  update_preprocessor();
+}
+
+void EchoCanceller::update_preprocessor() {
+  preprocessor_active = enable_suppression || enable_agc || enable_dereverb;
+
+  // the suppression gain of the preprocessor is applied to the residual echo and to the noise at the same time
+
+  int denoise = (enable_suppression) ? 1 : 0;
+  int agc = (enable_agc) ? 1 : 0;
+  int dereverb = (enable_dereverb) ? 1 : 0;
+
+  for (auto* state : preprocess_states) {
+    speex_preprocess_ctl(state, SPEEX_PREPROCESS_SET_DENOISE, &denoise);
+    speex_preprocess_ctl(state, SPEEX_PREPROCESS_SET_AGC, &agc);
+    speex_preprocess_ctl(state, SPEEX_PREPROCESS_SET_DEREVERB, &dereverb);
+    speex_preprocess_ctl(state, SPEEX_PREPROCESS_SET_NOISE_SUPPRESS, &noise_suppression);
+    speex_preprocess_ctl(state, SPEEX_PREPROCESS_SET_ECHO_SUPPRESS, &residual_echo_suppression);
+  }
 }
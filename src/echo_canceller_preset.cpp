@@ -37,6 +37,20 @@ void EchoCancellerPreset::save(nlohmann::json& json,
   json[section]["echo_canceller"]["frame-size"] = settings->get_int("frame-size");
 
   json[section]["echo_canceller"]["filter-length"] = settings->get_int("filter-length");
+
+  json[section]["echo_canceller"]["channel-mode"] = settings->get_string("channel-mode").c_str();
+
+  json[section]["echo_canceller"]["automatic-delay"] = settings->get_boolean("automatic-delay");
+
+  json[section]["echo_canceller"]["enable-suppression"] = settings->get_boolean("enable-suppression");
+
+  json[section]["echo_canceller"]["residual-echo-suppression"] = settings->get_int("residual-echo-suppression");
+
+  json[section]["echo_canceller"]["noise-suppression"] = settings->get_int("noise-suppression");
+
+  json[section]["echo_canceller"]["enable-agc"] = settings->get_boolean("enable-agc");
+
+  json[section]["echo_canceller"]["enable-dereverb"] = settings->get_boolean("enable-dereverb");
 }
 
 void EchoCancellerPreset::load(const nlohmann::json& json,
@@ -49,4 +63,19 @@ void EchoCancellerPreset::load(const nlohmann::json& json,
   update_key<int>(json.at(section).at("echo_canceller"), settings, "frame-size", "frame-size");
 
   update_key<int>(json.at(section).at("echo_canceller"), settings, "filter-length", "filter-length");
+
+  update_string_key(json.at(section).at("echo_canceller"), settings, "channel-mode", "channel-mode");
+
+  update_key<bool>(json.at(section).at("echo_canceller"), settings, "automatic-delay", "automatic-delay");
+
+  update_key<bool>(json.at(section).at("echo_canceller"), settings, "enable-suppression", "enable-suppression");
+
+  update_key<int>(json.at(section).at("echo_canceller"), settings, "residual-echo-suppression",
+                  "residual-echo-suppression");
+
+  update_key<int>(json.at(section).at("echo_canceller"), settings, "noise-suppression", "noise-suppression");
+
+  update_key<bool>(json.at(section).at("echo_canceller"), settings, "enable-agc", "enable-agc");
+
+  update_key<bool>(json.at(section).at("echo_canceller"), settings, "enable-dereverb", "enable-dereverb");
 }
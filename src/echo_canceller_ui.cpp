@@ -19,6 +19,33 @@
 
 #include "echo_canceller_ui.hpp"
 
+namespace {
+
+auto channel_mode_enum_to_int(GValue* value, GVariant* variant, gpointer user_data) -> gboolean {
+  const auto* v = g_variant_get_string(variant, nullptr);
+
+  if (g_strcmp0(v, "Stereo") == 0) {
+    g_value_set_int(value, 0);
+  } else if (g_strcmp0(v, "Mono Microphone") == 0) {
+    g_value_set_int(value, 1);
+  }
+
+  return 1;
+}
+
+auto int_to_channel_mode_enum(const GValue* value, const GVariantType* expected_type, gpointer user_data)
+    -> GVariant* {
+  switch (g_value_get_int(value)) {
+    case 1:
+      return g_variant_new_string("Mono Microphone");
+
+    default:
+      return g_variant_new_string("Stereo");
+  }
+}
+
+}  // namespace
+
 EchoCancellerUi::EchoCancellerUi(BaseObjectType* cobject,
                                  const Glib::RefPtr<Gtk::Builder>& builder,
                                  const std::string& schema,
@@ -31,13 +58,40 @@ EchoCancellerUi::EchoCancellerUi(BaseObjectType* cobject,
   frame_size = builder->get_widget<Gtk::SpinButton>("frame_size");
   filter_length = builder->get_widget<Gtk::SpinButton>("filter_length");
 
+  channel_mode = builder->get_widget<Gtk::ComboBoxText>("channel_mode");
+
+  automatic_delay = builder->get_widget<Gtk::ToggleButton>("automatic_delay");
+
+  reference_delay = builder->get_widget<Gtk::Label>("reference_delay");
+
+  enable_suppression = builder->get_widget<Gtk::ToggleButton>("enable_suppression");
+  enable_agc = builder->get_widget<Gtk::ToggleButton>("enable_agc");
+  enable_dereverb = builder->get_widget<Gtk::ToggleButton>("enable_dereverb");
+
+  residual_echo_suppression = builder->get_widget<Gtk::SpinButton>("residual_echo_suppression");
+  noise_suppression = builder->get_widget<Gtk::SpinButton>("noise_suppression");
+
   // gsettings bindings
 
   settings->bind("frame-size", frame_size->get_adjustment().get(), "value");
   settings->bind("filter-length", filter_length->get_adjustment().get(), "value");
 
+  g_settings_bind_with_mapping(settings->gobj(), "channel-mode", channel_mode->gobj(), "active",
+                               G_SETTINGS_BIND_DEFAULT, channel_mode_enum_to_int, int_to_channel_mode_enum, nullptr,
+                               nullptr);
+
+  settings->bind("automatic-delay", automatic_delay, "active");
+
+  settings->bind("enable-suppression", enable_suppression, "active");
+  settings->bind("residual-echo-suppression", residual_echo_suppression->get_adjustment().get(), "value");
+  settings->bind("noise-suppression", noise_suppression->get_adjustment().get(), "value");
+  settings->bind("enable-agc", enable_agc, "active");
+  settings->bind("enable-dereverb", enable_dereverb, "active");
+
   prepare_spinbutton(frame_size, "ms");
   prepare_spinbutton(filter_length, "ms");
+  prepare_spinbutton(residual_echo_suppression, "dB");
+  prepare_spinbutton(noise_suppression, "dB");
 
   setup_input_output_gain(builder);
 }
@@ -67,4 +121,22 @@ void EchoCancellerUi::reset() {
   settings->reset("frame-size");
 
   settings->reset("filter-length");
+
+  settings->reset("channel-mode");
+
+  settings->reset("automatic-delay");
+
+  settings->reset("enable-suppression");
+
+  settings->reset("residual-echo-suppression");
+
+  settings->reset("noise-suppression");
+
+  settings->reset("enable-agc");
+
+  settings->reset("enable-dereverb");
+}
+
+void EchoCancellerUi::on_new_reference_delay(const float& value) {
+  reference_delay->set_text(level_to_localized_string(value, 0) + " ms");
 }
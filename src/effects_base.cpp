@@ -201,6 +201,8 @@ EffectsBase::EffectsBase(std::string tag, const std::string& schema, PipeManager
 }
 
 EffectsBase::~EffectsBase() {
+  transition_timeout.disconnect();
+
   util::debug("effects_base: destroyed");
 }
 
@@ -226,6 +228,10 @@ auto EffectsBase::get_pipeline_latency() -> float {
   return total * 1000.0F;
 }
 
+auto EffectsBase::get_plugins_map() const -> const std::map<std::string, std::shared_ptr<PluginBase>>& {
+  return plugins;
+}
+
 void EffectsBase::broadcast_pipeline_latency() {
   const auto& latency_value = get_pipeline_latency();
 
@@ -233,3 +239,42 @@ void EffectsBase::broadcast_pipeline_latency() {
 
   Glib::signal_idle().connect_once([=, this] { pipeline_latency.emit(latency_value); });
 }
+
+void EffectsBase::run_preset_transition(const std::function<void()>& apply) {
+  const auto& duration = global_settings->get_int("preset-transition-time");
+
+  // the preset of a pending transition is replaced by this one
+
+  const bool pending = transition_timeout.connected();
+
+  transition_timeout.disconnect();
+
+  if (duration <= 0 || !output_level->connected_to_pw) {
+    apply();
+
+    if (pending) {
+      output_level->fade_in(0.001F * static_cast<float>(std::max(duration, 0)));
+    }
+
+    return;
+  }
+
+  util::debug(log_tag + "fading out the pipeline before changing the preset");
+
+  output_level->fade_out(0.001F * static_cast<float>(duration));
+
+  /*
+    PipeWire does not call process when nothing is playing. So instead of waiting for a notification from the realtime
+    thread we wait for the time the fade needs.
+  */
+
+  transition_timeout = Glib::signal_timeout().connect(
+      [=, this]() {
+        apply();
+
+        output_level->fade_in(0.001F * static_cast<float>(duration));
+
+        return false;
+      },
+      duration);
+}
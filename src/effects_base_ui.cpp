@@ -62,8 +62,6 @@ EffectsBaseUi::EffectsBaseUi(const Glib::RefPtr<Gtk::Builder>& builder,
   entry_plugins_search = builder->get_widget<Gtk::SearchEntry>("entry_plugins_search");
   stack_plugins = builder->get_widget<Gtk::Stack>("stack_plugins");
 
-  add_plugins_to_stack_plugins();
-
   // configuring widgets
 
   setup_listview_players();
@@ -71,7 +69,7 @@ EffectsBaseUi::EffectsBaseUi(const Glib::RefPtr<Gtk::Builder>& builder,
   setup_listview_plugins();
   setup_listview_selected_plugins();
 
-  settings->signal_changed("plugins").connect([&, this](const auto& key) { add_plugins_to_stack_plugins(); });
+  settings->signal_changed("plugins").connect([&, this](const auto& key) { remove_unselected_plugin_pages(); });
 
   // spectrum
 
@@ -153,33 +151,33 @@ EffectsBaseUi::EffectsBaseUi(const Glib::RefPtr<Gtk::Builder>& builder,
     scrolled_window_plugins->set_max_content_height(height);
   });
 
-  // enabling notifications
-
-  effects_base->autogain->post_messages = true;
-  effects_base->bass_enhancer->post_messages = true;
-  effects_base->bass_loudness->post_messages = true;
-  effects_base->compressor->post_messages = true;
-  effects_base->convolver->post_messages = true;
-  effects_base->crossfeed->post_messages = true;
-  effects_base->crystalizer->post_messages = true;
-  effects_base->deesser->post_messages = true;
-  effects_base->delay->post_messages = true;
-  effects_base->echo_canceller->post_messages = true;
-  effects_base->equalizer->post_messages = true;
-  effects_base->exciter->post_messages = true;
-  effects_base->filter->post_messages = true;
-  effects_base->gate->post_messages = true;
-  effects_base->limiter->post_messages = true;
-  effects_base->loudness->post_messages = true;
-  effects_base->maximizer->post_messages = true;
-  effects_base->multiband_compressor->post_messages = true;
-  effects_base->multiband_gate->post_messages = true;
+  // enabling notifications. The other plugins only send them while their page is the visible one
+
   effects_base->output_level->post_messages = true;
-  effects_base->pitch->post_messages = true;
-  effects_base->reverb->post_messages = true;
-  effects_base->rnnoise->post_messages = true;
   effects_base->spectrum->post_messages = true;
-  effects_base->stereo_tools->post_messages = true;
+
+  stack_plugins->connect_property_changed("visible-child", [=, this]() { on_visible_plugin_changed(); });
+
+  on_visible_plugin_changed();
+
+  /*
+    The plugins only publish their meter values. A single callback per display frame emits them for this pipeline.
+    GTK does not call it while the pipeline page is hidden.
+  */
+
+  meters_tick_id = stack_top->add_tick_callback([=, this](const Glib::RefPtr<Gdk::FrameClock>& frame_clock) {
+    effects_base->output_level->update_meters();
+
+    if (stack_plugins->get_mapped()) {
+      const auto& plugins_map = effects_base->get_plugins_map();
+
+      if (const auto& it = plugins_map.find(stack_plugins->get_visible_child_name().raw()); it != plugins_map.end()) {
+        it->second->update_meters();
+      }
+    }
+
+    return true;
+  });
 
   connections.push_back(effects_base->pipeline_latency.connect([=, this](const auto& v) {
     const auto& lv = Glib::ustring::format(std::setprecision(1), std::fixed, v);
@@ -199,6 +197,12 @@ EffectsBaseUi::~EffectsBaseUi() {
     c.disconnect();
   }
 
+  stack_top->remove_tick_callback(meters_tick_id);
+
+  for (auto& [name, c] : page_timeouts) {
+    c.disconnect();
+  }
+
   // do not send notifications when the window is closed
 
   effects_base->autogain->post_messages = false;
@@ -256,12 +260,40 @@ EffectsBaseUi::~EffectsBaseUi() {
   effects_base->stereo_tools->bypass = false;
 }
 
-void EffectsBaseUi::add_plugins_to_stack_plugins() {
-  std::string path = "/" + schema + "/";
+void EffectsBaseUi::on_visible_plugin_changed() {
+  const std::string visible_name = stack_plugins->get_visible_child_name();
 
-  std::replace(path.begin(), path.end(), '.', '/');
+  for (const auto& [name, plugin] : effects_base->get_plugins_map()) {
+    plugin->post_messages = (name == visible_name);
+  }
+
+  if (const auto& it = page_timeouts.find(visible_name); it != page_timeouts.end()) {
+    it->second.disconnect();
+
+    page_timeouts.erase(it);
+  }
+
+  // the page that was hidden is destroyed if it is not shown again for a while
+
+  if (!last_visible_plugin.empty() && last_visible_plugin != visible_name) {
+    const auto name = last_visible_plugin;
+
+    page_timeouts[name].disconnect();
+
+    page_timeouts[name] = Glib::signal_timeout().connect_seconds(
+        [=, this]() {
+          remove_hidden_plugin_page(name);
+
+          return false;
+        },
+        hidden_page_timeout);
+  }
+
+  last_visible_plugin = visible_name;
+}
 
-  // removing plugins that are not in the list
+void EffectsBaseUi::remove_unselected_plugin_pages() {
+  // removing plugins that are not in the list. The pages of the ones that are in it are created when they are shown
 
   for (auto* child = stack_plugins->get_first_child(); child != nullptr;) {
     auto found = false;
@@ -277,328 +309,407 @@ void EffectsBaseUi::add_plugins_to_stack_plugins() {
     auto* next_child = child->get_next_sibling();
 
     if (!found) {
+      const std::string name = stack_plugins->get_page(*child)->get_name();
+
+      if (const auto& it = page_timeouts.find(name); it != page_timeouts.end()) {
+        it->second.disconnect();
+
+        page_timeouts.erase(it);
+      }
+
       stack_plugins->remove(*child);
     }
 
     child = next_child;
   }
+}
 
-  // Adding to the stack the plugins in the list that are not there yet
-
-  for (const auto& name : settings->get_string_array("plugins")) {
-    auto found = false;
+void EffectsBaseUi::show_plugin_page(const std::string& name) {
+  auto* page = stack_plugins->get_child_by_name(name);
 
-    for (auto* child = stack_plugins->get_first_child(); child != nullptr; child = child->get_next_sibling()) {
-      if (name == stack_plugins->get_page(*child)->get_name()) {
-        found = true;
+  if (page == nullptr) {
+    const auto& list = settings->get_string_array("plugins");
 
-        break;
-      }
+    if (std::find(list.begin(), list.end(), name) == list.end()) {
+      return;
     }
 
-    if (found) {
-      continue;
-    }
+    util::debug(log_tag + "creating the page of the plugin " + name);
 
-    if (name == plugin_name::autogain) {
-      auto* const autogain_ui = AutoGainUi::add_to_stack(stack_plugins, path);
+    page = add_plugin_page(name);
+  }
 
-      autogain_ui->bypass->signal_toggled().connect(
-          [=, this]() { effects_base->autogain->bypass = autogain_ui->bypass->get_active(); });
+  if (page != nullptr) {
+    stack_plugins->set_visible_child(*page);
+  }
+}
 
-      effects_base->autogain->input_level.connect(sigc::mem_fun(*autogain_ui, &AutoGainUi::on_new_input_level));
-      effects_base->autogain->output_level.connect(sigc::mem_fun(*autogain_ui, &AutoGainUi::on_new_output_level));
-      effects_base->autogain->results.connect(sigc::mem_fun(*autogain_ui, &AutoGainUi::on_new_results));
+void EffectsBaseUi::remove_hidden_plugin_page(const std::string& name) {
+  page_timeouts.erase(name);
 
-      effects_base->autogain->bypass = false;
-    } else if (name == plugin_name::bass_enhancer) {
-      auto* const bass_enhancer_ui = BassEnhancerUi::add_to_stack(stack_plugins, path);
+  if (name == stack_plugins->get_visible_child_name().raw()) {
+    return;
+  }
 
-      bass_enhancer_ui->bypass->signal_toggled().connect(
-          [=, this]() { effects_base->bass_enhancer->bypass = bass_enhancer_ui->bypass->get_active(); });
+  if (auto* page = stack_plugins->get_child_by_name(name); page != nullptr) {
+    util::debug(log_tag + "destroying the hidden page of the plugin " + name);
 
-      effects_base->bass_enhancer->input_level.connect(
-          sigc::mem_fun(*bass_enhancer_ui, &BassEnhancerUi::on_new_input_level));
-      effects_base->bass_enhancer->output_level.connect(
-          sigc::mem_fun(*bass_enhancer_ui, &BassEnhancerUi::on_new_output_level));
-      effects_base->bass_enhancer->harmonics.connect(
-          sigc::mem_fun(*bass_enhancer_ui, &BassEnhancerUi::on_new_harmonics_level));
+    stack_plugins->remove(*page);
+  }
+}
 
-      effects_base->bass_enhancer->bypass = false;
-    } else if (name == plugin_name::bass_loudness) {
-      auto* const bass_loudness_ui = BassLoudnessUi::add_to_stack(stack_plugins, path);
+auto EffectsBaseUi::add_plugin_page(const std::string& name) -> Gtk::Widget* {
+  std::string path = "/" + schema + "/";
 
-      bass_loudness_ui->bypass->signal_toggled().connect(
-          [=, this]() { effects_base->bass_loudness->bypass = bass_loudness_ui->bypass->get_active(); });
+  std::replace(path.begin(), path.end(), '.', '/');
 
-      effects_base->bass_loudness->input_level.connect(
-          sigc::mem_fun(*bass_loudness_ui, &BassLoudnessUi::on_new_input_level));
-      effects_base->bass_loudness->output_level.connect(
-          sigc::mem_fun(*bass_loudness_ui, &BassLoudnessUi::on_new_output_level));
+  /*
+    The level signals are connected to methods of the page. They are disconnected automatically when the page is
+    destroyed.
+  */
 
-      effects_base->bass_loudness->bypass = false;
-    } else if (name == plugin_name::compressor) {
-      auto* const compressor_ui = CompressorUi::add_to_stack(stack_plugins, path);
+  Gtk::Widget* page = nullptr;
 
-      compressor_ui->bypass->signal_toggled().connect(
-          [=, this]() { effects_base->compressor->bypass = compressor_ui->bypass->get_active(); });
+  if (name == plugin_name::autogain) {
+    auto* const autogain_ui = AutoGainUi::add_to_stack(stack_plugins, path);
 
-      compressor_ui->set_pipe_manager_ptr(pm);
+    autogain_ui->bypass->set_active(effects_base->autogain->bypass);
 
-      effects_base->compressor->input_level.connect(sigc::mem_fun(*compressor_ui, &CompressorUi::on_new_input_level));
-      effects_base->compressor->output_level.connect(sigc::mem_fun(*compressor_ui, &CompressorUi::on_new_output_level));
-      effects_base->compressor->reduction.connect(sigc::mem_fun(*compressor_ui, &CompressorUi::on_new_reduction));
-      effects_base->compressor->envelope.connect(sigc::mem_fun(*compressor_ui, &CompressorUi::on_new_envelope));
-      effects_base->compressor->sidechain.connect(sigc::mem_fun(*compressor_ui, &CompressorUi::on_new_sidechain));
-      effects_base->compressor->curve.connect(sigc::mem_fun(*compressor_ui, &CompressorUi::on_new_curve));
+    autogain_ui->bypass->signal_toggled().connect(
+        [=, this]() { effects_base->autogain->bypass = autogain_ui->bypass->get_active(); });
 
-      effects_base->compressor->bypass = false;
-    } else if (name == plugin_name::convolver) {
-      auto* const convolver_ui = ConvolverUi::add_to_stack(stack_plugins, path);
+    effects_base->autogain->input_level.connect(sigc::mem_fun(*autogain_ui, &AutoGainUi::on_new_input_level));
+    effects_base->autogain->output_level.connect(sigc::mem_fun(*autogain_ui, &AutoGainUi::on_new_output_level));
+    effects_base->autogain->results.connect(sigc::mem_fun(*autogain_ui, &AutoGainUi::on_new_results));
 
-      convolver_ui->bypass->signal_toggled().connect(
-          [=, this]() { effects_base->convolver->bypass = convolver_ui->bypass->get_active(); });
+    page = autogain_ui;
+  } else if (name == plugin_name::bass_enhancer) {
+    auto* const bass_enhancer_ui = BassEnhancerUi::add_to_stack(stack_plugins, path);
 
-      convolver_ui->set_transient_window(transient_window);
+    bass_enhancer_ui->bypass->set_active(effects_base->bass_enhancer->bypass);
 
-      effects_base->convolver->input_level.connect(sigc::mem_fun(*convolver_ui, &ConvolverUi::on_new_input_level));
-      effects_base->convolver->output_level.connect(sigc::mem_fun(*convolver_ui, &ConvolverUi::on_new_output_level));
+    bass_enhancer_ui->bypass->signal_toggled().connect(
+        [=, this]() { effects_base->bass_enhancer->bypass = bass_enhancer_ui->bypass->get_active(); });
 
-      effects_base->convolver->bypass = false;
-    } else if (name == plugin_name::crossfeed) {
-      auto* const crossfeed_ui = CrossfeedUi::add_to_stack(stack_plugins, path);
+    effects_base->bass_enhancer->input_level.connect(
+        sigc::mem_fun(*bass_enhancer_ui, &BassEnhancerUi::on_new_input_level));
+    effects_base->bass_enhancer->output_level.connect(
+        sigc::mem_fun(*bass_enhancer_ui, &BassEnhancerUi::on_new_output_level));
+    effects_base->bass_enhancer->harmonics.connect(
+        sigc::mem_fun(*bass_enhancer_ui, &BassEnhancerUi::on_new_harmonics_level));
 
-      crossfeed_ui->bypass->signal_toggled().connect(
-          [=, this]() { effects_base->crossfeed->bypass = crossfeed_ui->bypass->get_active(); });
+    page = bass_enhancer_ui;
+  } else if (name == plugin_name::bass_loudness) {
+    auto* const bass_loudness_ui = BassLoudnessUi::add_to_stack(stack_plugins, path);
 
-      effects_base->crossfeed->input_level.connect(sigc::mem_fun(*crossfeed_ui, &CrossfeedUi::on_new_input_level));
-      effects_base->crossfeed->output_level.connect(sigc::mem_fun(*crossfeed_ui, &CrossfeedUi::on_new_output_level));
+    bass_loudness_ui->bypass->set_active(effects_base->bass_loudness->bypass);
 
-      effects_base->crossfeed->bypass = false;
-    } else if (name == plugin_name::crystalizer) {
-      auto* const crystalizer_ui = CrystalizerUi::add_to_stack(stack_plugins, path);
+    bass_loudness_ui->bypass->signal_toggled().connect(
+        [=, this]() { effects_base->bass_loudness->bypass = bass_loudness_ui->bypass->get_active(); });
 
-      crystalizer_ui->bypass->signal_toggled().connect(
-          [=, this]() { effects_base->crystalizer->bypass = crystalizer_ui->bypass->get_active(); });
+    effects_base->bass_loudness->input_level.connect(
+        sigc::mem_fun(*bass_loudness_ui, &BassLoudnessUi::on_new_input_level));
+    effects_base->bass_loudness->output_level.connect(
+        sigc::mem_fun(*bass_loudness_ui, &BassLoudnessUi::on_new_output_level));
 
-      effects_base->crystalizer->input_level.connect(
-          sigc::mem_fun(*crystalizer_ui, &CrystalizerUi::on_new_input_level));
-      effects_base->crystalizer->output_level.connect(
-          sigc::mem_fun(*crystalizer_ui, &CrystalizerUi::on_new_output_level));
+    page = bass_loudness_ui;
+  } else if (name == plugin_name::compressor) {
+    auto* const compressor_ui = CompressorUi::add_to_stack(stack_plugins, path);
 
-      effects_base->crystalizer->bypass = false;
-    } else if (name == plugin_name::deesser) {
-      auto* const deesser_ui = DeesserUi::add_to_stack(stack_plugins, path);
+    compressor_ui->bypass->set_active(effects_base->compressor->bypass);
 
-      deesser_ui->bypass->signal_toggled().connect(
-          [=, this]() { effects_base->deesser->bypass = deesser_ui->bypass->get_active(); });
+    compressor_ui->bypass->signal_toggled().connect(
+        [=, this]() { effects_base->compressor->bypass = compressor_ui->bypass->get_active(); });
 
-      effects_base->deesser->input_level.connect(sigc::mem_fun(*deesser_ui, &DeesserUi::on_new_input_level));
-      effects_base->deesser->output_level.connect(sigc::mem_fun(*deesser_ui, &DeesserUi::on_new_output_level));
-      effects_base->deesser->compression.connect(sigc::mem_fun(*deesser_ui, &DeesserUi::on_new_compression));
-      effects_base->deesser->detected.connect(sigc::mem_fun(*deesser_ui, &DeesserUi::on_new_detected));
+    compressor_ui->set_pipe_manager_ptr(pm);
 
-      effects_base->deesser->bypass = false;
-    } else if (name == plugin_name::delay) {
-      auto* const delay_ui = DelayUi::add_to_stack(stack_plugins, path);
+    effects_base->compressor->input_level.connect(sigc::mem_fun(*compressor_ui, &CompressorUi::on_new_input_level));
+    effects_base->compressor->output_level.connect(sigc::mem_fun(*compressor_ui, &CompressorUi::on_new_output_level));
+    effects_base->compressor->reduction.connect(sigc::mem_fun(*compressor_ui, &CompressorUi::on_new_reduction));
+    effects_base->compressor->envelope.connect(sigc::mem_fun(*compressor_ui, &CompressorUi::on_new_envelope));
+    effects_base->compressor->sidechain.connect(sigc::mem_fun(*compressor_ui, &CompressorUi::on_new_sidechain));
+    effects_base->compressor->curve.connect(sigc::mem_fun(*compressor_ui, &CompressorUi::on_new_curve));
 
-      delay_ui->bypass->signal_toggled().connect(
-          [=, this]() { effects_base->delay->bypass = delay_ui->bypass->get_active(); });
+    page = compressor_ui;
+  } else if (name == plugin_name::convolver) {
+    auto* const convolver_ui = ConvolverUi::add_to_stack(stack_plugins, path);
 
-      effects_base->delay->input_level.connect(sigc::mem_fun(*delay_ui, &DelayUi::on_new_input_level));
-      effects_base->delay->output_level.connect(sigc::mem_fun(*delay_ui, &DelayUi::on_new_output_level));
+    convolver_ui->bypass->set_active(effects_base->convolver->bypass);
 
-      effects_base->delay->bypass = false;
-    } else if (name == plugin_name::echo_canceller) {
-      auto* const echo_canceller_ui = EchoCancellerUi::add_to_stack(stack_plugins, path);
+    convolver_ui->bypass->signal_toggled().connect(
+        [=, this]() { effects_base->convolver->bypass = convolver_ui->bypass->get_active(); });
 
-      echo_canceller_ui->bypass->signal_toggled().connect(
-          [=, this]() { effects_base->echo_canceller->bypass = echo_canceller_ui->bypass->get_active(); });
+    convolver_ui->set_transient_window(transient_window);
 
-      effects_base->echo_canceller->input_level.connect(
-          sigc::mem_fun(*echo_canceller_ui, &EchoCancellerUi::on_new_input_level));
-      effects_base->echo_canceller->output_level.connect(
-          sigc::mem_fun(*echo_canceller_ui, &EchoCancellerUi::on_new_output_level));
+    effects_base->convolver->input_level.connect(sigc::mem_fun(*convolver_ui, &ConvolverUi::on_new_input_level));
+    effects_base->convolver->output_level.connect(sigc::mem_fun(*convolver_ui, &ConvolverUi::on_new_output_level));
 
-      effects_base->echo_canceller->bypass = false;
-    } else if (name == plugin_name::equalizer) {
-      auto* const equalizer_ui = EqualizerUi::add_to_stack(stack_plugins, path);
+    page = convolver_ui;
+  } else if (name == plugin_name::crossfeed) {
+    auto* const crossfeed_ui = CrossfeedUi::add_to_stack(stack_plugins, path);
 
-      equalizer_ui->bypass->signal_toggled().connect(
-          [=, this]() { effects_base->equalizer->bypass = equalizer_ui->bypass->get_active(); });
+    crossfeed_ui->bypass->set_active(effects_base->crossfeed->bypass);
 
-      equalizer_ui->set_transient_window(transient_window);
+    crossfeed_ui->bypass->signal_toggled().connect(
+        [=, this]() { effects_base->crossfeed->bypass = crossfeed_ui->bypass->get_active(); });
 
-      effects_base->equalizer->input_level.connect(sigc::mem_fun(*equalizer_ui, &EqualizerUi::on_new_input_level));
-      effects_base->equalizer->output_level.connect(sigc::mem_fun(*equalizer_ui, &EqualizerUi::on_new_output_level));
+    effects_base->crossfeed->input_level.connect(sigc::mem_fun(*crossfeed_ui, &CrossfeedUi::on_new_input_level));
+    effects_base->crossfeed->output_level.connect(sigc::mem_fun(*crossfeed_ui, &CrossfeedUi::on_new_output_level));
 
-      effects_base->equalizer->bypass = false;
-    } else if (name == plugin_name::exciter) {
-      auto* const exciter_ui = ExciterUi::add_to_stack(stack_plugins, path);
+    page = crossfeed_ui;
+  } else if (name == plugin_name::crystalizer) {
+    auto* const crystalizer_ui = CrystalizerUi::add_to_stack(stack_plugins, path);
 
-      exciter_ui->bypass->signal_toggled().connect(
-          [=, this]() { effects_base->exciter->bypass = exciter_ui->bypass->get_active(); });
+    crystalizer_ui->bypass->set_active(effects_base->crystalizer->bypass);
 
-      effects_base->exciter->input_level.connect(sigc::mem_fun(*exciter_ui, &ExciterUi::on_new_input_level));
-      effects_base->exciter->output_level.connect(sigc::mem_fun(*exciter_ui, &ExciterUi::on_new_output_level));
-      effects_base->exciter->harmonics.connect(sigc::mem_fun(*exciter_ui, &ExciterUi::on_new_harmonics_level));
+    crystalizer_ui->bypass->signal_toggled().connect(
+        [=, this]() { effects_base->crystalizer->bypass = crystalizer_ui->bypass->get_active(); });
 
-      effects_base->exciter->bypass = false;
-    } else if (name == plugin_name::filter) {
-      auto* const filter_ui = FilterUi::add_to_stack(stack_plugins, path);
+    effects_base->crystalizer->input_level.connect(sigc::mem_fun(*crystalizer_ui, &CrystalizerUi::on_new_input_level));
+    effects_base->crystalizer->output_level.connect(
+        sigc::mem_fun(*crystalizer_ui, &CrystalizerUi::on_new_output_level));
 
-      filter_ui->bypass->signal_toggled().connect(
-          [=, this]() { effects_base->filter->bypass = filter_ui->bypass->get_active(); });
+    page = crystalizer_ui;
+  } else if (name == plugin_name::deesser) {
+    auto* const deesser_ui = DeesserUi::add_to_stack(stack_plugins, path);
 
-      effects_base->filter->input_level.connect(sigc::mem_fun(*filter_ui, &FilterUi::on_new_input_level));
-      effects_base->filter->output_level.connect(sigc::mem_fun(*filter_ui, &FilterUi::on_new_output_level));
+    deesser_ui->bypass->set_active(effects_base->deesser->bypass);
 
-      effects_base->filter->bypass = false;
-    } else if (name == plugin_name::gate) {
-      auto* const gate_ui = GateUi::add_to_stack(stack_plugins, path);
+    deesser_ui->bypass->signal_toggled().connect(
+        [=, this]() { effects_base->deesser->bypass = deesser_ui->bypass->get_active(); });
 
-      gate_ui->bypass->signal_toggled().connect(
-          [=, this]() { effects_base->gate->bypass = gate_ui->bypass->get_active(); });
+    effects_base->deesser->input_level.connect(sigc::mem_fun(*deesser_ui, &DeesserUi::on_new_input_level));
+    effects_base->deesser->output_level.connect(sigc::mem_fun(*deesser_ui, &DeesserUi::on_new_output_level));
+    effects_base->deesser->compression.connect(sigc::mem_fun(*deesser_ui, &DeesserUi::on_new_compression));
+    effects_base->deesser->detected.connect(sigc::mem_fun(*deesser_ui, &DeesserUi::on_new_detected));
 
-      effects_base->gate->input_level.connect(sigc::mem_fun(*gate_ui, &GateUi::on_new_input_level));
-      effects_base->gate->output_level.connect(sigc::mem_fun(*gate_ui, &GateUi::on_new_output_level));
-      effects_base->gate->gating.connect(sigc::mem_fun(*gate_ui, &GateUi::on_new_gating));
+    page = deesser_ui;
+  } else if (name == plugin_name::delay) {
+    auto* const delay_ui = DelayUi::add_to_stack(stack_plugins, path);
 
-      effects_base->gate->bypass = false;
-    } else if (name == plugin_name::limiter) {
-      auto* const limiter_ui = LimiterUi::add_to_stack(stack_plugins, path);
+    delay_ui->bypass->set_active(effects_base->delay->bypass);
 
-      limiter_ui->bypass->signal_toggled().connect(
-          [=, this]() { effects_base->limiter->bypass = limiter_ui->bypass->get_active(); });
+    delay_ui->bypass->signal_toggled().connect(
+        [=, this]() { effects_base->delay->bypass = delay_ui->bypass->get_active(); });
 
-      effects_base->limiter->input_level.connect(sigc::mem_fun(*limiter_ui, &LimiterUi::on_new_input_level));
-      effects_base->limiter->output_level.connect(sigc::mem_fun(*limiter_ui, &LimiterUi::on_new_output_level));
-      effects_base->limiter->gain_left.connect(sigc::mem_fun(*limiter_ui, &LimiterUi::on_new_left_gain));
-      effects_base->limiter->gain_right.connect(sigc::mem_fun(*limiter_ui, &LimiterUi::on_new_right_gain));
-      effects_base->limiter->sidechain_left.connect(sigc::mem_fun(*limiter_ui, &LimiterUi::on_new_left_sidechain));
-      effects_base->limiter->sidechain_right.connect(sigc::mem_fun(*limiter_ui, &LimiterUi::on_new_right_sidechain));
+    effects_base->delay->input_level.connect(sigc::mem_fun(*delay_ui, &DelayUi::on_new_input_level));
+    effects_base->delay->output_level.connect(sigc::mem_fun(*delay_ui, &DelayUi::on_new_output_level));
 
-      effects_base->limiter->bypass = false;
-    } else if (name == plugin_name::loudness) {
-      auto* const loudness_ui = LoudnessUi::add_to_stack(stack_plugins, path);
+    page = delay_ui;
+  } else if (name == plugin_name::echo_canceller) {
+    auto* const echo_canceller_ui = EchoCancellerUi::add_to_stack(stack_plugins, path);
 
-      loudness_ui->bypass->signal_toggled().connect(
-          [=, this]() { effects_base->loudness->bypass = loudness_ui->bypass->get_active(); });
+    echo_canceller_ui->bypass->set_active(effects_base->echo_canceller->bypass);
 
-      effects_base->loudness->input_level.connect(sigc::mem_fun(*loudness_ui, &LoudnessUi::on_new_input_level));
-      effects_base->loudness->output_level.connect(sigc::mem_fun(*loudness_ui, &LoudnessUi::on_new_output_level));
+    echo_canceller_ui->bypass->signal_toggled().connect(
+        [=, this]() { effects_base->echo_canceller->bypass = echo_canceller_ui->bypass->get_active(); });
 
-      effects_base->loudness->bypass = false;
-    } else if (name == plugin_name::maximizer) {
-      auto* const maximizer_ui = MaximizerUi::add_to_stack(stack_plugins, path);
+    effects_base->echo_canceller->input_level.connect(
+        sigc::mem_fun(*echo_canceller_ui, &EchoCancellerUi::on_new_input_level));
+    effects_base->echo_canceller->output_level.connect(
+        sigc::mem_fun(*echo_canceller_ui, &EchoCancellerUi::on_new_output_level));
+    effects_base->echo_canceller->reference_delay.connect(
+        sigc::mem_fun(*echo_canceller_ui, &EchoCancellerUi::on_new_reference_delay));
 
-      maximizer_ui->bypass->signal_toggled().connect(
-          [=, this]() { effects_base->maximizer->bypass = maximizer_ui->bypass->get_active(); });
+    page = echo_canceller_ui;
+  } else if (name == plugin_name::equalizer) {
+    auto* const equalizer_ui = EqualizerUi::add_to_stack(stack_plugins, path);
 
-      effects_base->maximizer->input_level.connect(sigc::mem_fun(*maximizer_ui, &MaximizerUi::on_new_input_level));
-      effects_base->maximizer->output_level.connect(sigc::mem_fun(*maximizer_ui, &MaximizerUi::on_new_output_level));
-      effects_base->maximizer->reduction.connect(sigc::mem_fun(*maximizer_ui, &MaximizerUi::on_new_reduction));
+    equalizer_ui->bypass->set_active(effects_base->equalizer->bypass);
 
-      effects_base->maximizer->bypass = false;
-    } else if (name == plugin_name::multiband_compressor) {
-      auto* const multiband_compressor_ui = MultibandCompressorUi::add_to_stack(stack_plugins, path);
+    equalizer_ui->bypass->signal_toggled().connect(
+        [=, this]() { effects_base->equalizer->bypass = equalizer_ui->bypass->get_active(); });
 
-      multiband_compressor_ui->bypass->signal_toggled().connect(
-          [=, this]() { effects_base->multiband_compressor->bypass = multiband_compressor_ui->bypass->get_active(); });
+    equalizer_ui->set_transient_window(transient_window);
 
-      effects_base->multiband_compressor->input_level.connect(
-          sigc::mem_fun(*multiband_compressor_ui, &MultibandCompressorUi::on_new_input_level));
-      effects_base->multiband_compressor->output_level.connect(
-          sigc::mem_fun(*multiband_compressor_ui, &MultibandCompressorUi::on_new_output_level));
+    effects_base->equalizer->input_level.connect(sigc::mem_fun(*equalizer_ui, &EqualizerUi::on_new_input_level));
+    effects_base->equalizer->output_level.connect(sigc::mem_fun(*equalizer_ui, &EqualizerUi::on_new_output_level));
 
-      effects_base->multiband_compressor->frequency_range.connect(
-          sigc::mem_fun(*multiband_compressor_ui, &MultibandCompressorUi::on_new_frequency_range));
-      effects_base->multiband_compressor->envelope.connect(
-          sigc::mem_fun(*multiband_compressor_ui, &MultibandCompressorUi::on_new_envelope));
-      effects_base->multiband_compressor->curve.connect(
-          sigc::mem_fun(*multiband_compressor_ui, &MultibandCompressorUi::on_new_curve));
-      effects_base->multiband_compressor->reduction.connect(
-          sigc::mem_fun(*multiband_compressor_ui, &MultibandCompressorUi::on_new_reduction));
+    page = equalizer_ui;
+  } else if (name == plugin_name::exciter) {
+    auto* const exciter_ui = ExciterUi::add_to_stack(stack_plugins, path);
 
-      effects_base->multiband_compressor->bypass = false;
-    } else if (name == plugin_name::multiband_gate) {
-      auto* const multiband_gate_ui = MultibandGateUi::add_to_stack(stack_plugins, path);
+    exciter_ui->bypass->set_active(effects_base->exciter->bypass);
 
-      multiband_gate_ui->bypass->signal_toggled().connect(
-          [=, this]() { effects_base->multiband_gate->bypass = multiband_gate_ui->bypass->get_active(); });
+    exciter_ui->bypass->signal_toggled().connect(
+        [=, this]() { effects_base->exciter->bypass = exciter_ui->bypass->get_active(); });
 
-      effects_base->multiband_gate->input_level.connect(
-          sigc::mem_fun(*multiband_gate_ui, &MultibandGateUi::on_new_input_level));
-      effects_base->multiband_gate->output_level.connect(
-          sigc::mem_fun(*multiband_gate_ui, &MultibandGateUi::on_new_output_level));
+    effects_base->exciter->input_level.connect(sigc::mem_fun(*exciter_ui, &ExciterUi::on_new_input_level));
+    effects_base->exciter->output_level.connect(sigc::mem_fun(*exciter_ui, &ExciterUi::on_new_output_level));
+    effects_base->exciter->harmonics.connect(sigc::mem_fun(*exciter_ui, &ExciterUi::on_new_harmonics_level));
 
-      effects_base->multiband_gate->output0.connect(
-          sigc::mem_fun(*multiband_gate_ui, &MultibandGateUi::on_new_output0));
-      effects_base->multiband_gate->output1.connect(
-          sigc::mem_fun(*multiband_gate_ui, &MultibandGateUi::on_new_output1));
-      effects_base->multiband_gate->output2.connect(
-          sigc::mem_fun(*multiband_gate_ui, &MultibandGateUi::on_new_output2));
-      effects_base->multiband_gate->output3.connect(
-          sigc::mem_fun(*multiband_gate_ui, &MultibandGateUi::on_new_output3));
-
-      effects_base->multiband_gate->gating0.connect(
-          sigc::mem_fun(*multiband_gate_ui, &MultibandGateUi::on_new_gating0));
-      effects_base->multiband_gate->gating1.connect(
-          sigc::mem_fun(*multiband_gate_ui, &MultibandGateUi::on_new_gating1));
-      effects_base->multiband_gate->gating2.connect(
-          sigc::mem_fun(*multiband_gate_ui, &MultibandGateUi::on_new_gating2));
-      effects_base->multiband_gate->gating3.connect(
-          sigc::mem_fun(*multiband_gate_ui, &MultibandGateUi::on_new_gating3));
-
-      effects_base->multiband_gate->bypass = false;
-    } else if (name == plugin_name::pitch) {
-      auto* const pitch_ui = PitchUi::add_to_stack(stack_plugins, path);
-
-      pitch_ui->bypass->signal_toggled().connect(
-          [=, this]() { effects_base->pitch->bypass = pitch_ui->bypass->get_active(); });
-
-      effects_base->pitch->input_level.connect(sigc::mem_fun(*pitch_ui, &PitchUi::on_new_input_level));
-      effects_base->pitch->output_level.connect(sigc::mem_fun(*pitch_ui, &PitchUi::on_new_output_level));
-
-      effects_base->pitch->bypass = false;
-    } else if (name == plugin_name::reverb) {
-      auto* const reverb_ui = ReverbUi::add_to_stack(stack_plugins, path);
-
-      reverb_ui->bypass->signal_toggled().connect(
-          [=, this]() { effects_base->reverb->bypass = reverb_ui->bypass->get_active(); });
-
-      effects_base->reverb->input_level.connect(sigc::mem_fun(*reverb_ui, &ReverbUi::on_new_input_level));
-      effects_base->reverb->output_level.connect(sigc::mem_fun(*reverb_ui, &ReverbUi::on_new_output_level));
-
-      effects_base->reverb->bypass = false;
-    } else if (name == plugin_name::rnnoise) {
-      auto* const rnnoise_ui = RNNoiseUi::add_to_stack(stack_plugins, path);
-
-      rnnoise_ui->bypass->signal_toggled().connect(
-          [=, this]() { effects_base->rnnoise->bypass = rnnoise_ui->bypass->get_active(); });
-
-      rnnoise_ui->set_transient_window(transient_window);
-
-      effects_base->rnnoise->input_level.connect(sigc::mem_fun(*rnnoise_ui, &RNNoiseUi::on_new_input_level));
-      effects_base->rnnoise->output_level.connect(sigc::mem_fun(*rnnoise_ui, &RNNoiseUi::on_new_output_level));
-
-      effects_base->rnnoise->bypass = false;
-    } else if (name == plugin_name::stereo_tools) {
-      auto* const stereo_tools_ui = StereoToolsUi::add_to_stack(stack_plugins, path);
-
-      stereo_tools_ui->bypass->signal_toggled().connect(
-          [=, this]() { effects_base->stereo_tools->bypass = stereo_tools_ui->bypass->get_active(); });
-
-      effects_base->stereo_tools->input_level.connect(
-          sigc::mem_fun(*stereo_tools_ui, &StereoToolsUi::on_new_input_level));
-      effects_base->stereo_tools->output_level.connect(
-          sigc::mem_fun(*stereo_tools_ui, &StereoToolsUi::on_new_output_level));
-      effects_base->stereo_tools->new_correlation.connect(
-          sigc::mem_fun(*stereo_tools_ui, &StereoToolsUi::on_new_phase_correlation));
-
-      effects_base->stereo_tools->bypass = false;
-    }
+    page = exciter_ui;
+  } else if (name == plugin_name::filter) {
+    auto* const filter_ui = FilterUi::add_to_stack(stack_plugins, path);
+
+    filter_ui->bypass->set_active(effects_base->filter->bypass);
+
+    filter_ui->bypass->signal_toggled().connect(
+        [=, this]() { effects_base->filter->bypass = filter_ui->bypass->get_active(); });
+
+    effects_base->filter->input_level.connect(sigc::mem_fun(*filter_ui, &FilterUi::on_new_input_level));
+    effects_base->filter->output_level.connect(sigc::mem_fun(*filter_ui, &FilterUi::on_new_output_level));
+
+    page = filter_ui;
+  } else if (name == plugin_name::gate) {
+    auto* const gate_ui = GateUi::add_to_stack(stack_plugins, path);
+
+    gate_ui->bypass->set_active(effects_base->gate->bypass);
+
+    gate_ui->bypass->signal_toggled().connect(
+        [=, this]() { effects_base->gate->bypass = gate_ui->bypass->get_active(); });
+
+    effects_base->gate->input_level.connect(sigc::mem_fun(*gate_ui, &GateUi::on_new_input_level));
+    effects_base->gate->output_level.connect(sigc::mem_fun(*gate_ui, &GateUi::on_new_output_level));
+    effects_base->gate->gating.connect(sigc::mem_fun(*gate_ui, &GateUi::on_new_gating));
+
+    page = gate_ui;
+  } else if (name == plugin_name::limiter) {
+    auto* const limiter_ui = LimiterUi::add_to_stack(stack_plugins, path);
+
+    limiter_ui->bypass->set_active(effects_base->limiter->bypass);
+
+    limiter_ui->bypass->signal_toggled().connect(
+        [=, this]() { effects_base->limiter->bypass = limiter_ui->bypass->get_active(); });
+
+    effects_base->limiter->input_level.connect(sigc::mem_fun(*limiter_ui, &LimiterUi::on_new_input_level));
+    effects_base->limiter->output_level.connect(sigc::mem_fun(*limiter_ui, &LimiterUi::on_new_output_level));
+    effects_base->limiter->gain_left.connect(sigc::mem_fun(*limiter_ui, &LimiterUi::on_new_left_gain));
+    effects_base->limiter->gain_right.connect(sigc::mem_fun(*limiter_ui, &LimiterUi::on_new_right_gain));
+    effects_base->limiter->sidechain_left.connect(sigc::mem_fun(*limiter_ui, &LimiterUi::on_new_left_sidechain));
+    effects_base->limiter->sidechain_right.connect(sigc::mem_fun(*limiter_ui, &LimiterUi::on_new_right_sidechain));
+
+    page = limiter_ui;
+  } else if (name == plugin_name::loudness) {
+    auto* const loudness_ui = LoudnessUi::add_to_stack(stack_plugins, path);
+
+    loudness_ui->bypass->set_active(effects_base->loudness->bypass);
+
+    loudness_ui->bypass->signal_toggled().connect(
+        [=, this]() { effects_base->loudness->bypass = loudness_ui->bypass->get_active(); });
+
+    effects_base->loudness->input_level.connect(sigc::mem_fun(*loudness_ui, &LoudnessUi::on_new_input_level));
+    effects_base->loudness->output_level.connect(sigc::mem_fun(*loudness_ui, &LoudnessUi::on_new_output_level));
+
+    page = loudness_ui;
+  } else if (name == plugin_name::maximizer) {
+    auto* const maximizer_ui = MaximizerUi::add_to_stack(stack_plugins, path);
+
+    maximizer_ui->bypass->set_active(effects_base->maximizer->bypass);
+
+    maximizer_ui->bypass->signal_toggled().connect(
+        [=, this]() { effects_base->maximizer->bypass = maximizer_ui->bypass->get_active(); });
+
+    effects_base->maximizer->input_level.connect(sigc::mem_fun(*maximizer_ui, &MaximizerUi::on_new_input_level));
+    effects_base->maximizer->output_level.connect(sigc::mem_fun(*maximizer_ui, &MaximizerUi::on_new_output_level));
+    effects_base->maximizer->reduction.connect(sigc::mem_fun(*maximizer_ui, &MaximizerUi::on_new_reduction));
+
+    page = maximizer_ui;
+  } else if (name == plugin_name::multiband_compressor) {
+    auto* const multiband_compressor_ui = MultibandCompressorUi::add_to_stack(stack_plugins, path);
+
+    multiband_compressor_ui->bypass->set_active(effects_base->multiband_compressor->bypass);
+
+    multiband_compressor_ui->bypass->signal_toggled().connect(
+        [=, this]() { effects_base->multiband_compressor->bypass = multiband_compressor_ui->bypass->get_active(); });
+
+    effects_base->multiband_compressor->input_level.connect(
+        sigc::mem_fun(*multiband_compressor_ui, &MultibandCompressorUi::on_new_input_level));
+    effects_base->multiband_compressor->output_level.connect(
+        sigc::mem_fun(*multiband_compressor_ui, &MultibandCompressorUi::on_new_output_level));
+
+    effects_base->multiband_compressor->frequency_range.connect(
+        sigc::mem_fun(*multiband_compressor_ui, &MultibandCompressorUi::on_new_frequency_range));
+    effects_base->multiband_compressor->envelope.connect(
+        sigc::mem_fun(*multiband_compressor_ui, &MultibandCompressorUi::on_new_envelope));
+    effects_base->multiband_compressor->curve.connect(
+        sigc::mem_fun(*multiband_compressor_ui, &MultibandCompressorUi::on_new_curve));
+    effects_base->multiband_compressor->reduction.connect(
+        sigc::mem_fun(*multiband_compressor_ui, &MultibandCompressorUi::on_new_reduction));
+
+    page = multiband_compressor_ui;
+  } else if (name == plugin_name::multiband_gate) {
+    auto* const multiband_gate_ui = MultibandGateUi::add_to_stack(stack_plugins, path);
+
+    multiband_gate_ui->bypass->set_active(effects_base->multiband_gate->bypass);
+
+    multiband_gate_ui->bypass->signal_toggled().connect(
+        [=, this]() { effects_base->multiband_gate->bypass = multiband_gate_ui->bypass->get_active(); });
+
+    effects_base->multiband_gate->input_level.connect(
+        sigc::mem_fun(*multiband_gate_ui, &MultibandGateUi::on_new_input_level));
+    effects_base->multiband_gate->output_level.connect(
+        sigc::mem_fun(*multiband_gate_ui, &MultibandGateUi::on_new_output_level));
+
+    effects_base->multiband_gate->output0.connect(sigc::mem_fun(*multiband_gate_ui, &MultibandGateUi::on_new_output0));
+    effects_base->multiband_gate->output1.connect(sigc::mem_fun(*multiband_gate_ui, &MultibandGateUi::on_new_output1));
+    effects_base->multiband_gate->output2.connect(sigc::mem_fun(*multiband_gate_ui, &MultibandGateUi::on_new_output2));
+    effects_base->multiband_gate->output3.connect(sigc::mem_fun(*multiband_gate_ui, &MultibandGateUi::on_new_output3));
+
+    effects_base->multiband_gate->gating0.connect(sigc::mem_fun(*multiband_gate_ui, &MultibandGateUi::on_new_gating0));
+    effects_base->multiband_gate->gating1.connect(sigc::mem_fun(*multiband_gate_ui, &MultibandGateUi::on_new_gating1));
+    effects_base->multiband_gate->gating2.connect(sigc::mem_fun(*multiband_gate_ui, &MultibandGateUi::on_new_gating2));
+    effects_base->multiband_gate->gating3.connect(sigc::mem_fun(*multiband_gate_ui, &MultibandGateUi::on_new_gating3));
+
+    page = multiband_gate_ui;
+  } else if (name == plugin_name::pitch) {
+    auto* const pitch_ui = PitchUi::add_to_stack(stack_plugins, path);
+
+    pitch_ui->bypass->set_active(effects_base->pitch->bypass);
+
+    pitch_ui->bypass->signal_toggled().connect(
+        [=, this]() { effects_base->pitch->bypass = pitch_ui->bypass->get_active(); });
+
+    effects_base->pitch->input_level.connect(sigc::mem_fun(*pitch_ui, &PitchUi::on_new_input_level));
+    effects_base->pitch->output_level.connect(sigc::mem_fun(*pitch_ui, &PitchUi::on_new_output_level));
+
+    page = pitch_ui;
+  } else if (name == plugin_name::reverb) {
+    auto* const reverb_ui = ReverbUi::add_to_stack(stack_plugins, path);
+
+    reverb_ui->bypass->set_active(effects_base->reverb->bypass);
+
+    reverb_ui->bypass->signal_toggled().connect(
+        [=, this]() { effects_base->reverb->bypass = reverb_ui->bypass->get_active(); });
+
+    effects_base->reverb->input_level.connect(sigc::mem_fun(*reverb_ui, &ReverbUi::on_new_input_level));
+    effects_base->reverb->output_level.connect(sigc::mem_fun(*reverb_ui, &ReverbUi::on_new_output_level));
+
+    page = reverb_ui;
+  } else if (name == plugin_name::rnnoise) {
+    auto* const rnnoise_ui = RNNoiseUi::add_to_stack(stack_plugins, path);
+
+    rnnoise_ui->bypass->set_active(effects_base->rnnoise->bypass);
+
+    rnnoise_ui->bypass->signal_toggled().connect(
+        [=, this]() { effects_base->rnnoise->bypass = rnnoise_ui->bypass->get_active(); });
+
+    rnnoise_ui->set_transient_window(transient_window);
+
+    effects_base->rnnoise->input_level.connect(sigc::mem_fun(*rnnoise_ui, &RNNoiseUi::on_new_input_level));
+    effects_base->rnnoise->output_level.connect(sigc::mem_fun(*rnnoise_ui, &RNNoiseUi::on_new_output_level));
+    effects_base->rnnoise->voice_activity.connect(sigc::mem_fun(*rnnoise_ui, &RNNoiseUi::on_new_voice_activity));
+
+    page = rnnoise_ui;
+  } else if (name == plugin_name::stereo_tools) {
+    auto* const stereo_tools_ui = StereoToolsUi::add_to_stack(stack_plugins, path);
+
+    stereo_tools_ui->bypass->set_active(effects_base->stereo_tools->bypass);
+
+    stereo_tools_ui->bypass->signal_toggled().connect(
+        [=, this]() { effects_base->stereo_tools->bypass = stereo_tools_ui->bypass->get_active(); });
+
+    effects_base->stereo_tools->input_level.connect(
+        sigc::mem_fun(*stereo_tools_ui, &StereoToolsUi::on_new_input_level));
+    effects_base->stereo_tools->output_level.connect(
+        sigc::mem_fun(*stereo_tools_ui, &StereoToolsUi::on_new_output_level));
+    effects_base->stereo_tools->new_correlation.connect(
+        sigc::mem_fun(*stereo_tools_ui, &StereoToolsUi::on_new_phase_correlation));
+
+    page = stereo_tools_ui;
   }
+
+  return page;
 }
 
 void EffectsBaseUi::setup_listview_players() {
@@ -1109,15 +1220,7 @@ void EffectsBaseUi::setup_listview_selected_plugins() {
 
     // showing the first plugin in the list by default
 
-    const auto& selected_name = selected_plugins->get_string(0);
-
-    for (auto* child = stack_plugins->get_first_child(); child != nullptr; child = child->get_next_sibling()) {
-      if (stack_plugins->get_page(*child)->get_name() == selected_name) {
-        stack_plugins->set_visible_child(*child);
-
-        break;
-      }
-    }
+    show_plugin_page(selected_plugins->get_string(0).raw());
   }
 
   settings->signal_changed("plugins").connect([=, this](const auto& key) {
@@ -1128,7 +1231,13 @@ void EffectsBaseUi::setup_listview_selected_plugins() {
     if (!list.empty()) {
       auto* visible_child = stack_plugins->get_visible_child();
 
+      // there is no page yet when the first plugin is added to an empty list
+
       if (visible_child == nullptr) {
+        listview_selected_plugins->get_model()->select_item(0, true);
+
+        show_plugin_page(list[0].raw());
+
         return;
       }
 
@@ -1137,11 +1246,7 @@ void EffectsBaseUi::setup_listview_selected_plugins() {
       if (std::ranges::find(list, visible_page_name) == list.end()) {
         listview_selected_plugins->get_model()->select_item(0, true);
 
-        for (auto* child = stack_plugins->get_first_child(); child != nullptr; child = child->get_next_sibling()) {
-          if (stack_plugins->get_page(*child)->get_name() == list[0]) {
-            stack_plugins->set_visible_child(*child);
-          }
-        }
+        show_plugin_page(list[0].raw());
       } else {
         for (size_t m = 0U; m < list.size(); m++) {
           if (list[m] == visible_page_name) {
@@ -1169,13 +1274,7 @@ void EffectsBaseUi::setup_listview_selected_plugins() {
 
     const auto& selected_name = single->get_selected_item()->get_property<Glib::ustring>("string");
 
-    for (auto* child = stack_plugins->get_first_child(); child != nullptr; child = child->get_next_sibling()) {
-      if (stack_plugins->get_page(*child)->get_name() == selected_name) {
-        stack_plugins->set_visible_child(*child);
-
-        return;
-      }
-    }
+    show_plugin_page(selected_name.raw());
   });
 
   // setting the factory callbacks
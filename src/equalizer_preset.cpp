@@ -34,6 +34,10 @@ EqualizerPreset::EqualizerPreset()
 
   output_settings = Gio::Settings::create("com.github.wwmm.easyeffects.equalizer",
                                           "/com/github/wwmm/easyeffects/streamoutputs/equalizer/");
+
+  input_child_settings = {input_settings_left, input_settings_right};
+
+  output_child_settings = {output_settings_left, output_settings_right};
 }
 
 void EqualizerPreset::save(nlohmann::json& json,
@@ -95,11 +95,17 @@ void Exciter::process(std::span<float>& left_in,
 
       harmonics_port_value = static_cast<double>(lv2_wrapper->get_control_port_value("meter_drive"));
 
-      Glib::signal_idle().connect_once([=, this] { harmonics.emit(harmonics_port_value); });
-
       notify();
 
       notification_dt = 0.0F;
     }
   }
 }
+
+void Exciter::emit_meters() {
+  harmonics.emit(harmonics_port_value.load());
+}
+
+auto Exciter::set_realtime_parameter(const std::string& key, const Glib::VariantBase& value) -> bool {
+  return PluginBase::set_realtime_parameter(key, value) || lv2_wrapper->set_bound_key(settings, key, value);
+}
@@ -24,31 +24,40 @@ FirFilterBandpass::FirFilterBandpass(std::string tag) : FirFilterBase(std::move(
 FirFilterBandpass::~FirFilterBandpass() = default;
 
 void FirFilterBandpass::setup() {
-  const auto& lowpass_kernel = create_lowpass_kernel(max_frequency, transition_band);
+  kernel = create_bandpass_kernel(rate, min_frequency, max_frequency, transition_band);
+
+  delay = 0.5F * static_cast<float>(kernel.size() - 1U) / static_cast<float>(rate);
+
+  setup_zita();
+}
+
+auto FirFilterBandpass::create_bandpass_kernel(const uint& rate,
+                                               const float& min_frequency,
+                                               const float& max_frequency,
+                                               const float& transition_band) -> std::vector<float> {
+  const auto& lowpass_kernel = create_lowpass_kernel(rate, max_frequency, transition_band);
 
   // high-pass kernel
 
-  auto highpass_kernel = create_lowpass_kernel(min_frequency, transition_band);
+  auto highpass_kernel = create_lowpass_kernel(rate, min_frequency, transition_band);
 
   std::ranges::for_each(highpass_kernel, [](auto& v) { v *= -1.0F; });
 
   highpass_kernel[(highpass_kernel.size() - 1U) / 2U] += 1.0F;
 
-  kernel.resize(highpass_kernel.size());
+  std::vector<float> output(highpass_kernel.size());
 
   /*
     Creating a bandpass from a band reject through spectral inversion https://www.dspguide.com/ch16/4.htm
   */
 
-  for (size_t n = 0U; n < kernel.size(); n++) {
-    kernel[n] = lowpass_kernel[n] + highpass_kernel[n];
+  for (size_t n = 0U; n < output.size(); n++) {
+    output[n] = lowpass_kernel[n] + highpass_kernel[n];
   }
 
-  std::ranges::for_each(kernel, [](auto& v) { v *= -1.0F; });
-
-  kernel[(kernel.size() - 1U) / 2U] += 1.0F;
+  std::ranges::for_each(output, [](auto& v) { v *= -1.0F; });
 
-  delay = 0.5F * static_cast<float>(kernel.size() - 1U) / static_cast<float>(rate);
+  output[(output.size() - 1U) / 2U] += 1.0F;
 
-  setup_zita();
+  return output;
 }
@@ -0,0 +1,231 @@
+/*
+ *  Copyright © 2017-2022 Wellington Wallace
+ *
+ *  This file is part of EasyEffects.
+ *
+ *  EasyEffects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  EasyEffects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with EasyEffects.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "fir_filter_bank.hpp"
+
+FirFilterBank::FirFilterBank(std::string tag) : log_tag(std::move(tag)) {}
+
+FirFilterBank::~FirFilterBank() {
+  ready = false;
+
+  free_fftw();
+}
+
+void FirFilterBank::set_rate(const uint& value) {
+  rate = value;
+}
+
+void FirFilterBank::set_n_samples(const uint& value) {
+  n_samples = value;
+}
+
+void FirFilterBank::set_transition_band(const float& value) {
+  transition_band = value;
+}
+
+void FirFilterBank::set_frequencies(std::span<const float> value) {
+  frequencies.assign(value.begin(), value.end());
+}
+
+auto FirFilterBank::is_ready() const -> bool {
+  return ready;
+}
+
+auto FirFilterBank::get_delay() const -> float {
+  return delay;
+}
+
+void FirFilterBank::free_fftw() {
+  if (forward_plan != nullptr) {
+    fftwf_destroy_plan(forward_plan);
+  }
+
+  if (backward_plan != nullptr) {
+    fftwf_destroy_plan(backward_plan);
+  }
+
+  if (fft_time != nullptr) {
+    fftwf_free(fft_time);
+  }
+
+  if (fft_freq != nullptr) {
+    fftwf_free(fft_freq);
+  }
+
+  forward_plan = nullptr;
+  backward_plan = nullptr;
+  fft_time = nullptr;
+  fft_freq = nullptr;
+}
+
+void FirFilterBank::setup() {
+  ready = false;
+
+  free_fftw();
+
+  if (n_samples == 0U || rate == 0U || frequencies.size() < 2U) {
+    return;
+  }
+
+  const auto& n_bands = frequencies.size() - 1U;
+
+  std::vector<std::vector<float>> kernels(n_bands);
+
+  size_t kernel_size = 0U;
+
+  for (size_t n = 0U; n < n_bands; n++) {
+    kernels[n] =
+        FirFilterBandpass::create_bandpass_kernel(rate, frequencies[n], frequencies[n + 1U], transition_band);
+
+    kernel_size = std::max(kernel_size, kernels[n].size());
+  }
+
+  if (kernel_size == 0U) {
+    return;
+  }
+
+  delay = 0.5F * static_cast<float>(kernel_size - 1U) / static_cast<float>(rate);
+
+  fft_size = 2U * n_samples;
+  n_bins = fft_size / 2U + 1U;
+  n_partitions = (static_cast<uint>(kernel_size) + n_samples - 1U) / n_samples;
+
+  fft_time = fftwf_alloc_real(fft_size);
+  fft_freq = fftwf_alloc_complex(n_bins);
+
+  forward_plan = fftwf_plan_dft_r2c_1d(static_cast<int>(fft_size), fft_time, fft_freq, FFTW_ESTIMATE);
+  backward_plan = fftwf_plan_dft_c2r_1d(static_cast<int>(fft_size), fft_freq, fft_time, FFTW_ESTIMATE);
+
+  // The inverse fft is not normalized by fftw. We do it once here instead of doing it in every block
+
+  const float norm = 1.0F / static_cast<float>(fft_size);
+
+  kernel_spectra.resize(n_bands);
+
+  for (size_t n = 0U; n < n_bands; n++) {
+    auto& spectra = kernel_spectra[n];
+
+    spectra.re.resize(n_partitions * n_bins);
+    spectra.im.resize(n_partitions * n_bins);
+
+    for (uint p = 0U; p < n_partitions; p++) {
+      std::fill(fft_time, fft_time + fft_size, 0.0F);
+
+      for (uint m = 0U; m < n_samples && p * n_samples + m < kernels[n].size(); m++) {
+        fft_time[m] = kernels[n][p * n_samples + m] * norm;
+      }
+
+      fftwf_execute(forward_plan);
+
+      for (uint k = 0U; k < n_bins; k++) {
+        spectra.re[p * n_bins + k] = fft_freq[k][0];
+        spectra.im[p * n_bins + k] = fft_freq[k][1];
+      }
+    }
+  }
+
+  for (auto& channel : channels) {
+    channel.fdl_position = 0U;
+
+    channel.input.assign(fft_size, 0.0F);
+
+    channel.fdl.re.assign(n_partitions * n_bins, 0.0F);
+    channel.fdl.im.assign(n_partitions * n_bins, 0.0F);
+  }
+
+  accumulator.re.resize(n_bins);
+  accumulator.im.resize(n_bins);
+
+  util::debug(log_tag + "kernel size: " + std::to_string(kernel_size) +
+              ", partitions: " + std::to_string(n_partitions));
+
+  ready = true;
+}
+
+void FirFilterBank::process(std::span<const float> data_left,
+                            std::span<const float> data_right,
+                            std::span<std::vector<float>> bands_left,
+                            std::span<std::vector<float>> bands_right) {
+  if (!ready) {
+    return;
+  }
+
+  process_channel(channels[0], data_left, bands_left);
+  process_channel(channels[1], data_right, bands_right);
+}
+
+void FirFilterBank::process_channel(Channel& channel,
+                                    std::span<const float> data,
+                                    std::span<std::vector<float>> bands) {
+  // sliding the input window by one block and transforming it. This is the only forward fft done for this block
+
+  std::copy(channel.input.begin() + n_samples, channel.input.end(), channel.input.begin());
+
+  std::copy(data.begin(), data.begin() + n_samples, channel.input.begin() + n_samples);
+
+  std::copy(channel.input.begin(), channel.input.end(), fft_time);
+
+  fftwf_execute(forward_plan);
+
+  float* fdl_re = channel.fdl.re.data() + channel.fdl_position * n_bins;
+  float* fdl_im = channel.fdl.im.data() + channel.fdl_position * n_bins;
+
+  for (uint k = 0U; k < n_bins; k++) {
+    fdl_re[k] = fft_freq[k][0];
+    fdl_im[k] = fft_freq[k][1];
+  }
+
+  float* acc_re = accumulator.re.data();
+  float* acc_im = accumulator.im.data();
+
+  for (size_t n = 0U; n < bands.size() && n < kernel_spectra.size(); n++) {
+    std::fill(accumulator.re.begin(), accumulator.re.end(), 0.0F);
+    std::fill(accumulator.im.begin(), accumulator.im.end(), 0.0F);
+
+    // the partition p of the kernel is applied to the spectrum of the block received p blocks ago
+
+    for (uint p = 0U; p < n_partitions; p++) {
+      const auto& slot = (channel.fdl_position + n_partitions - p) % n_partitions;
+
+      const float* x_re = channel.fdl.re.data() + slot * n_bins;
+      const float* x_im = channel.fdl.im.data() + slot * n_bins;
+
+      const float* h_re = kernel_spectra[n].re.data() + p * n_bins;
+      const float* h_im = kernel_spectra[n].im.data() + p * n_bins;
+
+      for (uint k = 0U; k < n_bins; k++) {
+        acc_re[k] += x_re[k] * h_re[k] - x_im[k] * h_im[k];
+        acc_im[k] += x_re[k] * h_im[k] + x_im[k] * h_re[k];
+      }
+    }
+
+    for (uint k = 0U; k < n_bins; k++) {
+      fft_freq[k][0] = acc_re[k];
+      fft_freq[k][1] = acc_im[k];
+    }
+
+    fftwf_execute(backward_plan);
+
+    // only the second half of the window is free from circular convolution aliasing
+
+    std::copy(fft_time + n_samples, fft_time + fft_size, bands[n].begin());
+  }
+
+  channel.fdl_position = (channel.fdl_position + 1U) % n_partitions;
+}
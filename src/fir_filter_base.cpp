@@ -65,6 +65,11 @@ void FirFilterBase::setup() {}
 
 auto FirFilterBase::create_lowpass_kernel(const float& cutoff, const float& transition_band) const
     -> std::vector<float> {
+  return create_lowpass_kernel(rate, cutoff, transition_band);
+}
+
+auto FirFilterBase::create_lowpass_kernel(const uint& rate, const float& cutoff, const float& transition_band)
+    -> std::vector<float> {
   std::vector<float> output;
 
   if (rate == 0) {
@@ -96,11 +96,17 @@ void Gate::process(std::span<float>& left_in,
 
       gating_port_value = static_cast<double>(lv2_wrapper->get_control_port_value("gating"));
 
-      Glib::signal_idle().connect_once([=, this] { gating.emit(gating_port_value); });
-
       notify();
 
       notification_dt = 0.0F;
     }
   }
 }
+
+void Gate::emit_meters() {
+  gating.emit(gating_port_value.load());
+}
+
+auto Gate::set_realtime_parameter(const std::string& key, const Glib::VariantBase& value) -> bool {
+  return PluginBase::set_realtime_parameter(key, value) || lv2_wrapper->set_bound_key(settings, key, value);
+}
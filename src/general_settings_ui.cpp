@@ -31,6 +31,8 @@ GeneralSettingsUi::GeneralSettingsUi(BaseObjectType* cobject,
   enable_autostart = builder->get_widget<Gtk::Switch>("enable_autostart");
   shutdown_on_window_close = builder->get_widget<Gtk::Switch>("shutdown_on_window_close");
 
+  preset_transition_time = builder->get_widget<Gtk::SpinButton>("preset_transition_time");
+
   reset_settings = builder->get_widget<Gtk::Button>("reset_settings");
   about_button = builder->get_widget<Gtk::Button>("about_button");
 
@@ -42,10 +44,17 @@ GeneralSettingsUi::GeneralSettingsUi(BaseObjectType* cobject,
 
   about_button->signal_clicked().connect([=, this]() { app->activate_action("about"); });
 
+  preset_transition_time->signal_output().connect(
+      [=, this]() { return parse_spinbutton_output(preset_transition_time, "ms"); }, true);
+
+  preset_transition_time->signal_input().connect(
+      [=, this](double& new_value) { return parse_spinbutton_input(preset_transition_time, new_value); }, true);
+
   settings->bind("use-dark-theme", theme_switch, "active");
   settings->bind("process-all-inputs", process_all_inputs, "active");
   settings->bind("process-all-outputs", process_all_outputs, "active");
   settings->bind("shutdown-on-window-close", shutdown_on_window_close, "active");
+  settings->bind("preset-transition-time", preset_transition_time->get_adjustment().get(), "value");
 
   init_autostart_switch();
 }
@@ -112,7 +112,7 @@ void Limiter::process(std::span<float>& left_in,
 
     util::debug(log_tag + name + " latency: " + std::to_string(latency_port_value) + " s");
 
-    Glib::signal_idle().connect_once([=, this] { latency.emit(latency_port_value); });
+    Glib::signal_idle().connect_once([=, this] { latency.emit(latency_port_value.load()); });
 
     spa_process_latency_info latency_info{};
 
@@ -140,14 +140,20 @@ void Limiter::process(std::span<float>& left_in,
       sidechain_l_port_value = lv2_wrapper->get_control_port_value("sclm_l");
       sidechain_r_port_value = lv2_wrapper->get_control_port_value("sclm_r");
 
-      Glib::signal_idle().connect_once([=, this] { gain_left.emit(gain_l_port_value); });
-      Glib::signal_idle().connect_once([=, this] { gain_right.emit(gain_r_port_value); });
-      Glib::signal_idle().connect_once([=, this] { sidechain_left.emit(sidechain_l_port_value); });
-      Glib::signal_idle().connect_once([=, this] { sidechain_right.emit(sidechain_r_port_value); });
-
       notify();
 
       notification_dt = 0.0F;
     }
   }
 }
+
+void Limiter::emit_meters() {
+  gain_left.emit(gain_l_port_value.load());
+  gain_right.emit(gain_r_port_value.load());
+  sidechain_left.emit(sidechain_l_port_value.load());
+  sidechain_right.emit(sidechain_r_port_value.load());
+}
+
+auto Limiter::set_realtime_parameter(const std::string& key, const Glib::VariantBase& value) -> bool {
+  return PluginBase::set_realtime_parameter(key, value) || lv2_wrapper->set_bound_key(settings, key, value);
+}
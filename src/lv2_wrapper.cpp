@@ -19,6 +19,15 @@
 
 #include "lv2_wrapper.hpp"
 
+namespace {
+
+template <typename T>
+auto variant_value(const Glib::VariantBase& value) -> T {
+  return Glib::VariantBase::cast_dynamic<Glib::Variant<T>>(value).get();
+}
+
+}  // namespace
+
 namespace lv2 {
 
 auto lv2_printf(LV2_Log_Handle handle, LV2_URID type, const char* format, ...) -> int {
@@ -82,6 +91,12 @@ Lv2Wrapper::~Lv2Wrapper() {
   if (world != nullptr) {
     lilv_world_free(world);
   }
+
+  for (const auto& [settings, ids] : change_event_handlers) {
+    for (const auto& id : ids) {
+      g_signal_handler_disconnect(settings->gobj(), id);
+    }
+  }
 }
 
 void Lv2Wrapper::check_required_features() {
@@ -129,6 +144,7 @@ void Lv2Wrapper::create_ports() {
     port->name = lilv_node_as_string(port_name);
     port->symbol = lilv_node_as_string(lilv_port_get_symbol(plugin, lilv_port));
     port->value = std::isnan(values[n]) ? 0.0F : values[n];
+    port->next_value = port->value;
     port->optional = lilv_port_has_property(plugin, lilv_port, lv2_connectionOptional);
 
     // util::warning("port name: " + port.name);
@@ -142,6 +158,8 @@ void Lv2Wrapper::create_ports() {
 
     if (lilv_port_is_a(plugin, lilv_port, lv2_ControlPort)) {
       port->type = TYPE_CONTROL;
+
+      control_port_indices[port->symbol] = n;
     } else if (lilv_port_is_a(plugin, lilv_port, lv2_AudioPort)) {
       port->type = TYPE_AUDIO;
 
@@ -312,44 +330,71 @@ void Lv2Wrapper::activate() {
   lilv_instance_activate(instance);
 }
 
-void Lv2Wrapper::run() const {
+void Lv2Wrapper::run() {
   if (instance != nullptr) {
+    update_control_ports();
+
     lilv_instance_run(instance, n_samples);
   }
 }
 
+void Lv2Wrapper::update_control_ports() {
+  if (!control_values_pending.load(std::memory_order_acquire)) {
+    return;
+  }
+
+  std::unique_lock<std::mutex> lock(control_mutex, std::try_to_lock);
+
+  if (!lock.owns_lock() || transaction_depth != 0U) {
+    return;
+  }
+
+  for (auto& p : ports) {
+    if (p.type == PortType::TYPE_CONTROL && p.is_input) {
+      p.value = p.next_value;
+    }
+  }
+
+  control_values_pending.store(false, std::memory_order_relaxed);
+}
+
 void Lv2Wrapper::deactivate() {
   lilv_instance_deactivate(instance);
 }
 
 void Lv2Wrapper::set_control_port_value(const std::string& symbol, const float& value) {
-  auto found = false;
+  const auto& it = control_port_indices.find(symbol);
 
-  for (auto& p : ports) {
-    if (p.type == PortType::TYPE_CONTROL && p.symbol == symbol) {
-      if (!p.is_input) {
-        util::warning(log_tag + plugin_uri + " port " + symbol + " is not an input!");
+  if (it == control_port_indices.end()) {
+    util::warning(log_tag + plugin_uri + " port symbol not found: " + symbol);
 
-        return;
-      }
+    return;
+  }
 
-      p.value = value;
+  auto& p = ports[it->second];
 
-      found = true;
+  if (!p.is_input) {
+    util::warning(log_tag + plugin_uri + " port " + symbol + " is not an input!");
 
-      break;
-    }
+    return;
   }
 
-  if (!found) {
-    util::warning(log_tag + plugin_uri + " port symbol not found: " + symbol);
+  std::scoped_lock<std::mutex> lock(control_mutex);
+
+  p.next_value = value;
+
+  if (transaction_depth == 0U) {
+    control_values_pending.store(true, std::memory_order_release);
   }
 }
+
 auto Lv2Wrapper::get_control_port_value(const std::string& symbol) -> float {
-  for (const auto& p : ports) {
-    if (p.type == PortType::TYPE_CONTROL && p.symbol == symbol) {
-      return p.value;
-    }
+  // the input ports return the last value set by the main thread even if run() has not copied it yet
+
+  if (const auto& it = control_port_indices.find(symbol); it != control_port_indices.end()) {
+    const auto& p = ports[it->second];
+
+    return (p.is_input) ? p.next_value : p.value;
   }
 
   util::warning(log_tag + plugin_uri + " port symbol not found: " + symbol);
@@ -364,6 +409,11 @@ auto Lv2Wrapper::has_instance() -> bool {
 void Lv2Wrapper::bind_key_double(const Glib::RefPtr<Gio::Settings>& settings,
                                  const Glib::ustring& gsettings_key,
                                  const std::string& lv2_symbol) {
+  watch_transactions(settings);
+
+  add_key_binding(settings, gsettings_key, lv2_symbol,
+                  [](const Glib::VariantBase& v) { return static_cast<float>(variant_value<double>(v)); });
+
   set_control_port_value(lv2_symbol, static_cast<float>(settings->get_double(gsettings_key)));
 
   settings->signal_changed(gsettings_key).connect([=, this](const auto& key) {
@@ -374,6 +424,12 @@ void Lv2Wrapper::bind_key_double(const Glib::RefPtr<Gio::Settings>& settings,
 void Lv2Wrapper::bind_key_double_db(const Glib::RefPtr<Gio::Settings>& settings,
                                     const Glib::ustring& gsettings_key,
                                     const std::string& lv2_symbol) {
+  watch_transactions(settings);
+
+  add_key_binding(settings, gsettings_key, lv2_symbol, [](const Glib::VariantBase& v) {
+    return static_cast<float>(util::db_to_linear(variant_value<double>(v)));
+  });
+
   set_control_port_value(lv2_symbol, static_cast<float>(util::db_to_linear(settings->get_double(gsettings_key))));
 
   settings->signal_changed(gsettings_key).connect([=, this](const auto& key) {
@@ -384,6 +440,11 @@ void Lv2Wrapper::bind_key_double_db(const Glib::RefPtr<Gio::Settings>& settings,
 void Lv2Wrapper::bind_key_bool(const Glib::RefPtr<Gio::Settings>& settings,
                                const Glib::ustring& gsettings_key,
                                const std::string& lv2_symbol) {
+  watch_transactions(settings);
+
+  add_key_binding(settings, gsettings_key, lv2_symbol,
+                  [](const Glib::VariantBase& v) { return static_cast<float>(variant_value<bool>(v)); });
+
   set_control_port_value(lv2_symbol, static_cast<float>(settings->get_boolean(gsettings_key)));
 
   settings->signal_changed(gsettings_key).connect([=, this](const auto& key) {
@@ -394,6 +455,8 @@ void Lv2Wrapper::bind_key_bool(const Glib::RefPtr<Gio::Settings>& settings,
 void Lv2Wrapper::bind_key_enum(const Glib::RefPtr<Gio::Settings>& settings,
                                const Glib::ustring& gsettings_key,
                                const std::string& lv2_symbol) {
+  watch_transactions(settings);
+
   set_control_port_value(lv2_symbol, static_cast<float>(settings->get_enum(gsettings_key)));
 
   settings->signal_changed(gsettings_key).connect([=, this](const auto& key) {
@@ -404,6 +467,11 @@ void Lv2Wrapper::bind_key_enum(const Glib::RefPtr<Gio::Settings>& settings,
 void Lv2Wrapper::bind_key_int(const Glib::RefPtr<Gio::Settings>& settings,
                               const Glib::ustring& gsettings_key,
                               const std::string& lv2_symbol) {
+  watch_transactions(settings);
+
+  add_key_binding(settings, gsettings_key, lv2_symbol,
+                  [](const Glib::VariantBase& v) { return static_cast<float>(variant_value<int>(v)); });
+
   set_control_port_value(lv2_symbol, static_cast<float>(settings->get_int(gsettings_key)));
 
   settings->signal_changed(gsettings_key).connect([=, this](const auto& key) {
@@ -411,6 +479,85 @@ void Lv2Wrapper::bind_key_int(const Glib::RefPtr<Gio::Settings>& settings,
   });
 }
 
+void Lv2Wrapper::add_key_binding(const Glib::RefPtr<Gio::Settings>& settings,
+                                 const Glib::ustring& gsettings_key,
+                                 const std::string& lv2_symbol,
+                                 const std::function<float(const Glib::VariantBase&)>& to_port_value) {
+  key_bindings[gsettings_key.raw()].push_back({settings->gobj(), lv2_symbol, to_port_value});
+}
+
+auto Lv2Wrapper::set_bound_key(const Glib::RefPtr<Gio::Settings>& settings,
+                               const std::string& gsettings_key,
+                               const Glib::VariantBase& value) -> bool {
+  const auto& it = key_bindings.find(gsettings_key);
+
+  if (it == key_bindings.end()) {
+    return false;
+  }
+
+  bool found = false;
+
+  for (const auto& binding : it->second) {
+    if (binding.settings == settings->gobj()) {
+      set_control_port_value(binding.lv2_symbol, binding.to_port_value(value));
+
+      found = true;
+    }
+  }
+
+  return found;
+}
+
+void Lv2Wrapper::watch_transactions(const Glib::RefPtr<Gio::Settings>& settings) {
+  for (const auto& [s, ids] : change_event_handlers) {
+    if (s == settings) {
+      return;
+    }
+  }
+
+  /*
+    GSettings emits change-event once with all the keys of a transaction before it emits the changed signal of each
+    key. Our handler runs before the ones emitting the changed signals and the one connected after runs when they are
+    done.
+  */
+
+  const auto before = g_signal_connect(settings->gobj(), "change-event", G_CALLBACK(on_change_event_begin), this);
+
+  const auto after = g_signal_connect_after(settings->gobj(), "change-event", G_CALLBACK(on_change_event_end), this);
+
+  change_event_handlers.emplace_back(settings, std::array<gulong, 2U>{before, after});
+}
+
+auto Lv2Wrapper::on_change_event_begin(GSettings* settings, gpointer keys, gint n_keys, Lv2Wrapper* self) -> gboolean {
+  self->begin_transaction();
+
+  return FALSE;
+}
+
+auto Lv2Wrapper::on_change_event_end(GSettings* settings, gpointer keys, gint n_keys, Lv2Wrapper* self) -> gboolean {
+  self->end_transaction();
+
+  return FALSE;
+}
+
+void Lv2Wrapper::begin_transaction() {
+  std::scoped_lock<std::mutex> lock(control_mutex);
+
+  transaction_depth++;
+}
+
+void Lv2Wrapper::end_transaction() {
+  std::scoped_lock<std::mutex> lock(control_mutex);
+
+  if (transaction_depth > 0U) {
+    transaction_depth--;
+  }
+
+  if (transaction_depth == 0U) {
+    control_values_pending.store(true, std::memory_order_release);
+  }
+}
+
 auto Lv2Wrapper::map_urid(const std::string& uri) -> LV2_URID {
   if (map_uri_to_urid.contains(uri)) {
     return map_uri_to_urid[uri];
@@ -91,7 +91,7 @@ void Maximizer::process(std::span<float>& left_in,
 
     util::debug(log_tag + name + " latency: " + std::to_string(latency_port_value) + " s");
 
-    Glib::signal_idle().connect_once([=, this] { latency.emit(latency_port_value); });
+    Glib::signal_idle().connect_once([=, this] { latency.emit(latency_port_value.load()); });
 
     spa_process_latency_info latency_info{};
 
@@ -118,11 +118,17 @@ void Maximizer::process(std::span<float>& left_in,
 
       reduction_port_value = static_cast<double>(lv2_wrapper->get_control_port_value("gr"));
 
-      Glib::signal_idle().connect_once([=, this] { reduction.emit(reduction_port_value); });
-
       notify();
 
       notification_dt = 0.0F;
     }
   }
 }
+
+void Maximizer::emit_meters() {
+  reduction.emit(reduction_port_value.load());
+}
+
+auto Maximizer::set_realtime_parameter(const std::string& key, const Glib::VariantBase& value) -> bool {
+  return PluginBase::set_realtime_parameter(key, value) || lv2_wrapper->set_bound_key(settings, key, value);
+}
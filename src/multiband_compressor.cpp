@@ -174,16 +174,32 @@ void MultibandCompressor::process(std::span<float>& left_in,
         reduction_port_array.at(n) = lv2_wrapper->get_control_port_value("rlm_" + nstr);
       }
 
-      Glib::signal_idle().connect_once([=, this] {
-        frequency_range.emit(frequency_range_end_port_array);
-        envelope.emit(envelope_port_array);
-        curve.emit(curve_port_array);
-        reduction.emit(reduction_port_array);
-      });
-
       notify();
 
       notification_dt = 0.0F;
     }
   }
 }
+
+void MultibandCompressor::emit_meters() {
+  // the arrays are written by the PipeWire thread. The signals get a copy of their current values
+
+  auto snapshot = [](const std::array<std::atomic<float>, n_bands>& values) {
+    std::array<float, n_bands> copy{};
+
+    for (uint n = 0U; n < n_bands; n++) {
+      copy.at(n) = values.at(n).load();
+    }
+
+    return copy;
+  };
+
+  frequency_range.emit(snapshot(frequency_range_end_port_array));
+  envelope.emit(snapshot(envelope_port_array));
+  curve.emit(snapshot(curve_port_array));
+  reduction.emit(snapshot(reduction_port_array));
+}
+
+auto MultibandCompressor::set_realtime_parameter(const std::string& key, const Glib::VariantBase& value) -> bool {
+  return PluginBase::set_realtime_parameter(key, value) || lv2_wrapper->set_bound_key(settings, key, value);
+}
@@ -185,21 +185,25 @@ void MultibandGate::process(std::span<float>& left_in,
       gating2_port_value = static_cast<double>(lv2_wrapper->get_control_port_value("gating2"));
       gating3_port_value = static_cast<double>(lv2_wrapper->get_control_port_value("gating3"));
 
-      Glib::signal_idle().connect_once([=, this] {
-        output0.emit(output0_port_value);
-        output1.emit(output1_port_value);
-        output2.emit(output2_port_value);
-        output3.emit(output3_port_value);
-
-        gating0.emit(gating0_port_value);
-        gating1.emit(gating1_port_value);
-        gating2.emit(gating2_port_value);
-        gating3.emit(gating3_port_value);
-      });
-
       notify();
 
       notification_dt = 0.0F;
     }
   }
 }
+
+void MultibandGate::emit_meters() {
+  output0.emit(output0_port_value.load());
+  output1.emit(output1_port_value.load());
+  output2.emit(output2_port_value.load());
+  output3.emit(output3_port_value.load());
+
+  gating0.emit(gating0_port_value.load());
+  gating1.emit(gating1_port_value.load());
+  gating2.emit(gating2_port_value.load());
+  gating3.emit(gating3_port_value.load());
+}
+
+auto MultibandGate::set_realtime_parameter(const std::string& key, const Glib::VariantBase& value) -> bool {
+  return PluginBase::set_realtime_parameter(key, value) || lv2_wrapper->set_bound_key(settings, key, value);
+}
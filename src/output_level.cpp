@@ -41,8 +41,23 @@ void OutputLevel::process(std::span<float>& left_in,
                           std::span<float>& right_in,
                           std::span<float>& left_out,
                           std::span<float>& right_out) {
-  std::copy(left_in.begin(), left_in.end(), left_out.begin());
-  std::copy(right_in.begin(), right_in.end(), right_out.begin());
+  const float target = fade_target.load(std::memory_order_relaxed);
+
+  if (fade_gain == 1.0F && target == 1.0F) {
+    std::copy(left_in.begin(), left_in.end(), left_out.begin());
+    std::copy(right_in.begin(), right_in.end(), right_out.begin());
+  } else {
+    const float duration = fade_duration.load(std::memory_order_relaxed);
+
+    const float step = (duration > 0.0F) ? 1.0F / (duration * static_cast<float>(rate)) : 1.0F;
+
+    for (size_t n = 0U; n < left_in.size(); n++) {
+      fade_gain = (fade_gain < target) ? std::min(fade_gain + step, target) : std::max(fade_gain - step, target);
+
+      left_out[n] = left_in[n] * fade_gain;
+      right_out[n] = right_in[n] * fade_gain;
+    }
+  }
 
   if (post_messages) {
     get_peaks(left_in, right_in, left_out, right_out);
@@ -56,3 +71,15 @@ void OutputLevel::process(std::span<float>& left_in,
     }
   }
 }
+
+void OutputLevel::fade_out(const float& duration) {
+  fade_duration.store(duration, std::memory_order_relaxed);
+
+  fade_target.store(0.0F, std::memory_order_relaxed);
+}
+
+void OutputLevel::fade_in(const float& duration) {
+  fade_duration.store(duration, std::memory_order_relaxed);
+
+  fade_target.store(1.0F, std::memory_order_relaxed);
+}
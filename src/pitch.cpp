@@ -33,19 +33,19 @@ Pitch::Pitch(const std::string& tag,
   cents = settings->get_int("cents");
 
   settings->signal_changed("crispness").connect([=, this](const auto& key) {
-    crispness = settings->get_int("crispness");
+    std::scoped_lock<std::recursive_mutex> lock(data_mutex);
 
-    std::scoped_lock<std::mutex> lock(data_mutex);
+    crispness = settings->get_int(key);
 
-    update_crispness();
+    update_crispness(stretcher.get());
   });
 
   settings->signal_changed("formant-preserving").connect([=, this](const auto& key) {
-    formant_preserving = settings->get_boolean(key);
+    std::scoped_lock<std::recursive_mutex> lock(data_mutex);
 
-    std::scoped_lock<std::mutex> lock(data_mutex);
+    formant_preserving = settings->get_boolean(key);
 
-    if (!rubberband_ready) {
+    if (stretcher == nullptr) {
       return;
     }
 
@@ -54,11 +54,11 @@ Pitch::Pitch(const std::string& tag,
   });
 
   settings->signal_changed("faster").connect([=, this](const auto& key) {
-    faster = settings->get_boolean(key);
+    std::scoped_lock<std::recursive_mutex> lock(data_mutex);
 
-    std::scoped_lock<std::mutex> lock(data_mutex);
+    faster = settings->get_boolean(key);
 
-    if (!rubberband_ready) {
+    if (stretcher == nullptr) {
       return;
     }
 
@@ -67,27 +67,27 @@ Pitch::Pitch(const std::string& tag,
   });
 
   settings->signal_changed("octaves").connect([=, this](const auto& key) {
-    octaves = settings->get_int(key);
+    std::scoped_lock<std::recursive_mutex> lock(data_mutex);
 
-    std::scoped_lock<std::mutex> lock(data_mutex);
+    octaves = settings->get_int(key);
 
-    update_pitch_scale();
+    update_pitch_scale(stretcher.get());
   });
 
   settings->signal_changed("semitones").connect([=, this](const auto& key) {
-    semitones = settings->get_int(key);
+    std::scoped_lock<std::recursive_mutex> lock(data_mutex);
 
-    std::scoped_lock<std::mutex> lock(data_mutex);
+    semitones = settings->get_int(key);
 
-    update_pitch_scale();
+    update_pitch_scale(stretcher.get());
   });
 
   settings->signal_changed("cents").connect([=, this](const auto& key) {
-    cents = settings->get_int(key);
+    std::scoped_lock<std::recursive_mutex> lock(data_mutex);
 
-    std::scoped_lock<std::mutex> lock(data_mutex);
+    cents = settings->get_int(key);
 
-    update_pitch_scale();
+    update_pitch_scale(stretcher.get());
   });
 
   setup_input_output_gain();
@@ -98,27 +98,36 @@ Pitch::~Pitch() {
     disconnect_from_pw();
   }
 
+  // the builder locks data_mutex. It has to finish before anything else is destroyed
+
+  if (builder.joinable()) {
+    builder.request_stop();
+
+    builder.join();
+  }
+
   util::debug(log_tag + name + " destroyed");
 }
 
 void Pitch::setup() {
-  rubberband_ready = false;
+  std::scoped_lock<std::recursive_mutex> lock(data_mutex);
 
-  latency_n_frames = 0U;
+  if (stretcher != nullptr && n_samples <= stretcher_max_process_size) {
+    if (rate == stretcher_rate) {
+      return;
+    }
 
-  deque_out_L.resize(0);
-  deque_out_R.resize(0);
+    // the pitch scale does not depend on the sampling rate. So the current stretcher runs until the new one is ready
+  } else {
+    rubberband_ready = false;
+  }
 
   /*
    RubberBand initialization is slow. It is better to do it outside of the plugin realtime thread
  */
 
-  Glib::signal_idle().connect_once([&, this] {
-    init_stretcher();
-
-    std::scoped_lock<std::mutex> lock(data_mutex);
-
-    rubberband_ready = true;
+  Glib::signal_idle().connect_once([=, this, new_rate = rate, max_size = std::max(n_samples, min_max_process_size)] {
+    builder = std::jthread([=, this](const std::stop_token& stoken) { build_stretcher(stoken, new_rate, max_size); });
   });
 }
 
@@ -126,7 +135,7 @@ void Pitch::process(std::span<float>& left_in,
                     std::span<float>& right_in,
                     std::span<float>& left_out,
                     std::span<float>& right_out) {
-  std::scoped_lock<std::mutex> lock(data_mutex);
+  std::scoped_lock<std::recursive_mutex> lock(data_mutex);
 
   if (bypass || !rubberband_ready) {
     std::copy(left_in.begin(), left_in.end(), left_out.begin());
@@ -176,13 +185,12 @@ void Pitch::process(std::span<float>& left_in,
   } else {
     const uint offset = left_out.size() - deque_out_L.size();
 
-    if (offset != latency_n_frames) {
-      latency_n_frames = offset;
+    /*
+      The latency was set from the start delay of the primed stretcher. A short block after that is treated as a
+      dropout. Reporting it here would only make the latency grow and it would be done from the realtime thread.
+    */
 
-      notify_latency = true;
-    }
-
-    for (uint n = 0U; !deque_out_L.empty() && n < left_out.size(); n++) {
+    for (uint n = 0U; n < left_out.size(); n++) {
       if (n < offset) {
         left_out[n] = 0.0F;
         right_out[n] = 0.0F;
@@ -237,52 +245,52 @@ void Pitch::process(std::span<float>& left_in,
   }
 }
 
-void Pitch::update_crispness() {
-  if (stretcher == nullptr) {
+void Pitch::update_crispness(RubberBand::RubberBandStretcher* s) const {
+  if (s == nullptr) {
     return;
   }
 
   switch (crispness) {
     case 0:
-      stretcher->setTransientsOption(RubberBand::RubberBandStretcher::OptionTransientsSmooth);
-      stretcher->setPhaseOption(RubberBand::RubberBandStretcher::OptionPhaseIndependent);
-      stretcher->setDetectorOption(RubberBand::RubberBandStretcher::OptionDetectorCompound);
+      s->setTransientsOption(RubberBand::RubberBandStretcher::OptionTransientsSmooth);
+      s->setPhaseOption(RubberBand::RubberBandStretcher::OptionPhaseIndependent);
+      s->setDetectorOption(RubberBand::RubberBandStretcher::OptionDetectorCompound);
 
       break;
     case 1:
-      stretcher->setTransientsOption(RubberBand::RubberBandStretcher::OptionTransientsCrisp);
-      stretcher->setPhaseOption(RubberBand::RubberBandStretcher::OptionPhaseIndependent);
-      stretcher->setDetectorOption(RubberBand::RubberBandStretcher::OptionDetectorSoft);
+      s->setTransientsOption(RubberBand::RubberBandStretcher::OptionTransientsCrisp);
+      s->setPhaseOption(RubberBand::RubberBandStretcher::OptionPhaseIndependent);
+      s->setDetectorOption(RubberBand::RubberBandStretcher::OptionDetectorSoft);
 
       break;
     case 2:
-      stretcher->setTransientsOption(RubberBand::RubberBandStretcher::OptionTransientsSmooth);
-      stretcher->setPhaseOption(RubberBand::RubberBandStretcher::OptionPhaseIndependent);
-      stretcher->setDetectorOption(RubberBand::RubberBandStretcher::OptionDetectorCompound);
+      s->setTransientsOption(RubberBand::RubberBandStretcher::OptionTransientsSmooth);
+      s->setPhaseOption(RubberBand::RubberBandStretcher::OptionPhaseIndependent);
+      s->setDetectorOption(RubberBand::RubberBandStretcher::OptionDetectorCompound);
 
       break;
     case 3:
-      stretcher->setTransientsOption(RubberBand::RubberBandStretcher::OptionTransientsSmooth);
-      stretcher->setPhaseOption(RubberBand::RubberBandStretcher::OptionPhaseLaminar);
-      stretcher->setDetectorOption(RubberBand::RubberBandStretcher::OptionDetectorCompound);
+      s->setTransientsOption(RubberBand::RubberBandStretcher::OptionTransientsSmooth);
+      s->setPhaseOption(RubberBand::RubberBandStretcher::OptionPhaseLaminar);
+      s->setDetectorOption(RubberBand::RubberBandStretcher::OptionDetectorCompound);
 
       break;
     case 4:
-      stretcher->setTransientsOption(RubberBand::RubberBandStretcher::OptionTransientsMixed);
-      stretcher->setPhaseOption(RubberBand::RubberBandStretcher::OptionPhaseLaminar);
-      stretcher->setDetectorOption(RubberBand::RubberBandStretcher::OptionDetectorCompound);
+      s->setTransientsOption(RubberBand::RubberBandStretcher::OptionTransientsMixed);
+      s->setPhaseOption(RubberBand::RubberBandStretcher::OptionPhaseLaminar);
+      s->setDetectorOption(RubberBand::RubberBandStretcher::OptionDetectorCompound);
 
       break;
     case 5:
-      stretcher->setTransientsOption(RubberBand::RubberBandStretcher::OptionTransientsCrisp);
-      stretcher->setPhaseOption(RubberBand::RubberBandStretcher::OptionPhaseLaminar);
-      stretcher->setDetectorOption(RubberBand::RubberBandStretcher::OptionDetectorCompound);
+      s->setTransientsOption(RubberBand::RubberBandStretcher::OptionTransientsCrisp);
+      s->setPhaseOption(RubberBand::RubberBandStretcher::OptionPhaseLaminar);
+      s->setDetectorOption(RubberBand::RubberBandStretcher::OptionDetectorCompound);
 
       break;
     case 6:
-      stretcher->setTransientsOption(RubberBand::RubberBandStretcher::OptionTransientsCrisp);
-      stretcher->setPhaseOption(RubberBand::RubberBandStretcher::OptionPhaseIndependent);
-      stretcher->setDetectorOption(RubberBand::RubberBandStretcher::OptionDetectorCompound);
+      s->setTransientsOption(RubberBand::RubberBandStretcher::OptionTransientsCrisp);
+      s->setPhaseOption(RubberBand::RubberBandStretcher::OptionPhaseIndependent);
+      s->setDetectorOption(RubberBand::RubberBandStretcher::OptionDetectorCompound);
 
       break;
   }
@@ -294,8 +302,8 @@ void Pitch::update_crispness() {
   https://github.com/breakfastquay/rubberband/blob/cc937ebe655fc3c902ad0bc5cb63ce4e782720ee/ladspa/RubberBandPitchShifter.cpp#L377
 */
 
-void Pitch::update_pitch_scale() {
-  if (stretcher == nullptr) {
+void Pitch::update_pitch_scale(RubberBand::RubberBandStretcher* s) const {
+  if (s == nullptr) {
     return;
   }
 
@@ -303,29 +311,107 @@ void Pitch::update_pitch_scale() {
 
   const double ratio = std::pow(2.0, n_octaves);
 
-  stretcher->setPitchScale(ratio);
+  s->setPitchScale(ratio);
 }
 
-void Pitch::init_stretcher() {
-  delete stretcher;
+void Pitch::configure_stretcher(RubberBand::RubberBandStretcher* s) const {
+  s->setFormantOption(formant_preserving ? RubberBand::RubberBandStretcher::OptionFormantPreserved
+                                         : RubberBand::RubberBandStretcher::OptionFormantShifted);
+
+  s->setPitchOption(faster ? RubberBand::RubberBandStretcher::OptionPitchHighSpeed
+                           : RubberBand::RubberBandStretcher::OptionPitchHighConsistency);
+
+  s->setTimeRatio(time_ratio);
+
+  update_crispness(s);
+  update_pitch_scale(s);
+}
 
+void Pitch::build_stretcher(const std::stop_token& stoken, const uint& new_rate, const uint& max_process_size) {
   RubberBand::RubberBandStretcher::Options options = RubberBand::RubberBandStretcher::OptionProcessRealTime |
                                                      RubberBand::RubberBandStretcher::OptionPitchHighConsistency |
                                                      RubberBand::RubberBandStretcher::OptionChannelsTogether |
                                                      RubberBand::RubberBandStretcher::OptionPhaseIndependent;
 
-  stretcher = new RubberBand::RubberBandStretcher(rate, 2, options);
+  auto new_stretcher = std::make_unique<RubberBand::RubberBandStretcher>(new_rate, 2, options);
 
-  stretcher->setMaxProcessSize(n_samples);
+  new_stretcher->setMaxProcessSize(max_process_size);
 
-  stretcher->setFormantOption(formant_preserving ? RubberBand::RubberBandStretcher::OptionFormantPreserved
-                                                 : RubberBand::RubberBandStretcher::OptionFormantShifted);
+  // the start delay depends on the pitch scale. So the stretcher has to be configured before being primed
 
-  stretcher->setPitchOption(faster ? RubberBand::RubberBandStretcher::OptionPitchHighSpeed
-                                   : RubberBand::RubberBandStretcher::OptionPitchHighConsistency);
+  {
+    std::scoped_lock<std::recursive_mutex> lock(data_mutex);
 
-  stretcher->setTimeRatio(time_ratio);
+    configure_stretcher(new_stretcher.get());
+  }
+
+  /*
+    Priming the stretcher with silence. Its output already has the real start delay when it replaces the current one
+    and the reported latency matches it.
+  */
+
+#if RUBBERBAND_API_MAJOR_VERSION > 2 || (RUBBERBAND_API_MAJOR_VERSION == 2 && RUBBERBAND_API_MINOR_VERSION >= 7)
+  const auto pad = new_stretcher->getPreferredStartPad();
+  const auto start_delay = new_stretcher->getStartDelay();
+#else
+  const size_t pad = 0U;
+  const auto start_delay = new_stretcher->getLatency();
+#endif
+
+  std::vector<float> silence(max_process_size, 0.0F);
+  std::vector<float> preroll_L, preroll_R;
+
+  std::array<float*, 2U> preroll_in = {silence.data(), silence.data()};
+  std::array<float*, 2U> preroll_out = {nullptr, nullptr};
+
+  for (size_t n = 0U; n < pad; n += max_process_size) {
+    if (stoken.stop_requested()) {
+      return;
+    }
+
+    new_stretcher->process(preroll_in.data(), std::min(pad - n, static_cast<size_t>(max_process_size)), false);
+
+    if (const auto& n_available = new_stretcher->available(); n_available > 0) {
+      const auto& offset = preroll_L.size();
+
+      preroll_L.resize(offset + n_available);
+      preroll_R.resize(offset + n_available);
+
+      preroll_out[0] = preroll_L.data() + offset;
+      preroll_out[1] = preroll_R.data() + offset;
+
+      new_stretcher->retrieve(preroll_out.data(), n_available);
+    }
+  }
+
+  util::debug(log_tag + name + " stretcher start pad: " + std::to_string(pad) +
+              ", start delay: " + std::to_string(start_delay));
+
+  {
+    std::scoped_lock<std::recursive_mutex> lock(data_mutex);
+
+    if (stoken.stop_requested()) {
+      return;
+    }
+
+    // settings may have changed while the stretcher was being primed
+
+    configure_stretcher(new_stretcher.get());
+
+    stretcher.swap(new_stretcher);
+
+    stretcher_rate = new_rate;
+    stretcher_max_process_size = max_process_size;
+
+    deque_out_L.assign(preroll_L.begin(), preroll_L.end());
+    deque_out_R.assign(preroll_R.begin(), preroll_R.end());
+
+    latency_n_frames = static_cast<uint>(start_delay);
+
+    notify_latency = true;
+
+    rubberband_ready = true;
+  }
 
-  update_crispness();
-  update_pitch_scale();
+  // the previous stretcher is destroyed here, outside of the lock
 }
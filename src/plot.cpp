@@ -29,6 +29,8 @@ Plot::Plot(Gtk::DrawingArea* drawing_area)
 
   // signals connection
 
+  da->property_scale_factor().signal_changed().connect([=, this]() { x_labels_valid = false; });
+
   da->add_controller(controller_motion);
 
   controller_motion->signal_motion().connect([=, this](const double& x, const double& y) {
@@ -69,46 +71,138 @@ Plot::~Plot() {
 
 void Plot::set_plot_type(const PlotType& value) {
   plot_type = value;
+
+  // the history is started from scratch every time the spectrogram is shown
+
+  spectrogram_surface.reset();
+  spectrogram_pattern.reset();
 }
 
 void Plot::set_plot_scale(const PlotScale& value) {
   plot_scale = value;
+
+  x_labels_valid = false;
 }
 
 void Plot::set_data(const std::vector<float>& x, const std::vector<float>& y) {
-  original_x = x;
-  original_y = y;
+  init_axes(x, y);
 
-  init_axes();
+  if (plot_type == PlotType::spectrogram) {
+    write_spectrogram_row(y);
+  }
 
   da->queue_draw();
 }
 
-void Plot::init_axes() {
-  x_min = std::ranges::min(original_x);
-  x_max = std::ranges::max(original_x);
+void Plot::write_spectrogram_row(const std::vector<float>& y) {
+  if (y.empty()) {
+    return;
+  }
 
-  y_min = std::ranges::min(original_y);
-  y_max = std::ranges::max(original_y);
+  // the history is discarded when the number of points changes
 
-  x_axis.resize(0);
-  y_axis.resize(0);
+  if (spectrogram_surface == nullptr || spectrogram_surface->get_width() != static_cast<int>(y.size())) {
+    spectrogram_surface =
+        Cairo::ImageSurface::create(Cairo::Surface::Format::ARGB32, static_cast<int>(y.size()), spectrogram_history);
 
-  for (const auto& v : original_x) {
-    if (v >= x_min && v <= x_max) {
-      x_axis.push_back(v);
-    }
+    spectrogram_pattern = Cairo::SurfacePattern::create(spectrogram_surface);
+
+    // each point is a solid block like the bars of the other plot types
+
+    spectrogram_pattern->set_filter(Cairo::SurfacePattern::Filter::FAST);
+
+    spectrogram_row = 0;
   }
 
-  for (const auto& v : original_y) {
-    if (v >= y_min && v <= y_max) {
-      y_axis.push_back(v);
-    }
+  spectrogram_surface->flush();
+
+  auto* row = reinterpret_cast<uint32_t*>(spectrogram_surface->get_data() +
+                                          static_cast<ptrdiff_t>(spectrogram_row) * spectrogram_surface->get_stride());
+
+  // the colors go from the background color to the plot color. The pixels are stored as opaque native endian argb
+
+  const auto& range = spectrogram_max - spectrogram_min;
+
+  for (size_t n = 0U; n < y.size(); n++) {
+    const auto v = std::clamp((y[n] - spectrogram_min) / range, 0.0F, 1.0F);
+
+    const auto& r = background_color.get_red() + v * (color.get_red() - background_color.get_red());
+    const auto& g = background_color.get_green() + v * (color.get_green() - background_color.get_green());
+    const auto& b = background_color.get_blue() + v * (color.get_blue() - background_color.get_blue());
+
+    row[n] = 0xff000000U | (static_cast<uint32_t>(255.0F * r) << 16U) | (static_cast<uint32_t>(255.0F * g) << 8U) |
+             static_cast<uint32_t>(255.0F * b);
+  }
+
+  spectrogram_surface->mark_dirty();
+
+  spectrogram_row = (spectrogram_row + 1) % spectrogram_history;
+}
+
+void Plot::init_axes(const std::vector<float>& x, const std::vector<float>& y) {
+  if (x.empty() || y.empty()) {
+    y_axis.resize(0);
+
+    return;
+  }
+
+  const auto& [new_x_min, new_x_max] = std::ranges::minmax(x);
+  const auto& [new_y_min, new_y_max] = std::ranges::minmax(y);
+
+  if (new_x_min != x_min || new_x_max != x_max) {
+    x_labels_valid = false;
+  }
+
+  x_min = new_x_min;
+  x_max = new_x_max;
+
+  y_min = new_y_min;
+  y_max = new_y_max;
+
+  /*
+    The y axis is updated in place. After the first call it already has the right capacity and nothing is allocated
+    when new data arrives. Only the x range is needed to draw.
+  */
+
+  y_axis.assign(y.begin(), y.end());
+}
+
+void Plot::update_objects_x(const int& width) {
+  if (width == objects_x_width && objects_x.size() == y_axis.size()) {
+    return;
+  }
+
+  objects_x = util::linspace(line_width, static_cast<float>(width) - line_width, y_axis.size());
+
+  objects_x_width = width;
+}
+
+void Plot::decimate(const int& width) {
+  columns_min.resize(width);
+  columns_max.resize(width);
+
+  std::ranges::fill(columns_min, std::numeric_limits<float>::max());
+  std::ranges::fill(columns_max, std::numeric_limits<float>::lowest());
+
+  const auto& n_points = y_axis.size();
+
+  // the point n falls in the column n * width / n_points. With more points than columns no column is left empty
+
+  for (size_t n = 0U; n < n_points; n++) {
+    const auto& c = n * static_cast<size_t>(width) / n_points;
+
+    columns_min[c] = std::min(columns_min[c], y_axis[n]);
+    columns_max[c] = std::max(columns_max[c], y_axis[n]);
   }
 
-  // making each y value a number between 0 and 1
+  // making each value a number between 0 and 1
+
+  const auto& y_range = y_max - y_min;
 
-  std::ranges::for_each(y_axis, [&](auto& v) { v = (v - y_min) / (y_max - y_min); });
+  for (int c = 0; c < width; c++) {
+    columns_min[c] = (columns_min[c] - y_min) / y_range;
+    columns_max[c] = (columns_max[c] - y_min) / y_range;
+  }
 }
 
 void Plot::set_background_color(const float& r, const float& g, const float& b, const float& alpha) {
@@ -137,10 +231,14 @@ void Plot::set_fill_bars(const bool& v) {
 
 void Plot::set_n_x_labels(const int& v) {
   n_x_labels = v;
+
+  x_labels_valid = false;
 }
 
 void Plot::set_n_x_decimals(const int& v) {
   n_x_decimals = v;
+
+  x_labels_valid = false;
 }
 
 void Plot::set_n_y_decimals(const int& v) {
@@ -149,6 +247,8 @@ void Plot::set_n_y_decimals(const int& v) {
 
 void Plot::set_x_unit(const Glib::ustring& value) {
   x_unit = value;
+
+  x_labels_valid = false;
 }
 
 void Plot::set_y_unit(const Glib::ustring& value) {
@@ -158,19 +258,41 @@ void Plot::set_y_unit(const Glib::ustring& value) {
 void Plot::on_draw(const Cairo::RefPtr<Cairo::Context>& ctx, const int& width, const int& height) {
   ctx->paint();
 
-  if (const auto& n_points = y_axis.size(); n_points > 0) {
-    const auto& objects_x = util::linspace(line_width, static_cast<float>(width) - line_width, n_points);
-
+  if (const auto& n_points = y_axis.size(); n_points > 0 && width > 0) {
     x_axis_height = draw_x_labels(ctx, width, height);
 
     int usable_height = height - x_axis_height;
 
+    if (plot_type == PlotType::spectrogram) {
+      draw_spectrogram(ctx, width, usable_height);
+    }
+
     ctx->set_source_rgba(color.get_red(), color.get_green(), color.get_blue(), color.get_alpha());
 
+    const auto& y_range = y_max - y_min;
+
+    const auto& decimated = n_points > static_cast<size_t>(width);
+
+    if (decimated) {
+      decimate(width);
+    } else {
+      update_objects_x(width);
+    }
+
     switch (plot_type) {
       case PlotType::bar: {
+        if (decimated) {
+          for (int c = 0; c < width; c++) {
+            const double bar_height = static_cast<double>(usable_height) * columns_max[c];
+
+            ctx->rectangle(c, static_cast<double>(usable_height) - bar_height, 1.0, bar_height);
+          }
+
+          break;
+        }
+
         for (uint n = 0U; n < n_points; n++) {
-          double bar_height = static_cast<double>(usable_height) * y_axis[n];
+          double bar_height = static_cast<double>(usable_height) * (y_axis[n] - y_min) / y_range;
 
           if (draw_bar_border) {
             ctx->rectangle(objects_x[n], static_cast<double>(usable_height) - bar_height,
@@ -186,10 +308,21 @@ void Plot::on_draw(const Cairo::RefPtr<Cairo::Context>& ctx, const int& width, c
       case PlotType::line: {
         ctx->move_to(0, usable_height);
 
-        for (uint n = 0U; n < n_points - 1U; n++) {
-          const auto& bar_height = y_axis[n] * static_cast<float>(usable_height);
+        if (decimated) {
+          // a vertical segment per column covers all the values of the points in it
+
+          for (int c = 0; c < width; c++) {
+            const auto& x = static_cast<double>(c) + 0.5;
+
+            ctx->line_to(x, static_cast<float>(usable_height) * (1.0F - columns_min[c]));
+            ctx->line_to(x, static_cast<float>(usable_height) * (1.0F - columns_max[c]));
+          }
+        } else {
+          for (uint n = 0U; n < n_points - 1U; n++) {
+            const auto& bar_height = (y_axis[n] - y_min) / y_range * static_cast<float>(usable_height);
 
-          ctx->line_to(objects_x[n], static_cast<float>(usable_height) - bar_height);
+            ctx->line_to(objects_x[n], static_cast<float>(usable_height) - bar_height);
+          }
         }
 
         ctx->line_to(width, usable_height);
@@ -200,6 +333,9 @@ void Plot::on_draw(const Cairo::RefPtr<Cairo::Context>& ctx, const int& width, c
 
         break;
       }
+      case PlotType::spectrogram: {
+        break;
+      }
     }
 
     ctx->set_line_width(line_width);
@@ -211,9 +347,13 @@ void Plot::on_draw(const Cairo::RefPtr<Cairo::Context>& ctx, const int& width, c
     }
 
     if (controller_motion->contains_pointer()) {
-      const auto& msg =
-          "x = " + Glib::ustring::format(std::setprecision(n_x_decimals), std::fixed, mouse_x) + " " + x_unit +
-          "  y = " + Glib::ustring::format(std::setprecision(n_y_decimals), std::fixed, mouse_y) + " " + y_unit;
+      auto msg = "x = " + Glib::ustring::format(std::setprecision(n_x_decimals), std::fixed, mouse_x) + " " + x_unit;
+
+      // the vertical axis of the spectrogram is the time
+
+      if (plot_type != PlotType::spectrogram) {
+        msg += "  y = " + Glib::ustring::format(std::setprecision(n_y_decimals), std::fixed, mouse_y) + " " + y_unit;
+      }
 
       Pango::FontDescription font;
       font.set_family("Monospace");
@@ -232,8 +372,53 @@ void Plot::on_draw(const Cairo::RefPtr<Cairo::Context>& ctx, const int& width, c
   }
 }
 
-auto Plot::draw_x_labels(const Cairo::RefPtr<Cairo::Context>& ctx, const int& width, const int& height) -> int {
-  const double labels_offset = width / static_cast<double>(n_x_labels);
+void Plot::draw_spectrogram(const Cairo::RefPtr<Cairo::Context>& ctx, const int& width, const int& height) {
+  if (spectrogram_surface == nullptr || height <= 0) {
+    return;
+  }
+
+  /*
+    The oldest row is drawn at the top and the newest one right above the x axis labels. So the rows from
+    spectrogram_row to the end of the surface go first and the rows before spectrogram_row go below them. The two
+    pieces come from the same surface. Only the pattern offset is different.
+  */
+
+  ctx->save();
+
+  ctx->rectangle(0.0, 0.0, width, height);
+
+  ctx->clip();
+
+  ctx->scale(static_cast<double>(width) / spectrogram_surface->get_width(),
+             static_cast<double>(height) / spectrogram_history);
+
+  ctx->rectangle(0.0, 0.0, spectrogram_surface->get_width(), spectrogram_history - spectrogram_row);
+
+  spectrogram_pattern->set_matrix(Cairo::translation_matrix(0.0, spectrogram_row));
+
+  ctx->set_source(spectrogram_pattern);
+
+  ctx->fill();
+
+  if (spectrogram_row > 0) {
+    ctx->rectangle(0.0, spectrogram_history - spectrogram_row, spectrogram_surface->get_width(), spectrogram_row);
+
+    spectrogram_pattern->set_matrix(Cairo::translation_matrix(0.0, spectrogram_row - spectrogram_history));
+
+    ctx->set_source(spectrogram_pattern);
+
+    ctx->fill();
+  }
+
+  ctx->restore();
+}
+
+void Plot::build_x_labels() {
+  x_labels.clear();
+
+  x_labels_height = 0;
+
+  x_labels_valid = true;
 
   std::vector<float> labels;
 
@@ -250,21 +435,18 @@ auto Plot::draw_x_labels(const Cairo::RefPtr<Cairo::Context>& ctx, const int& wi
     }
   }
 
-  ctx->set_source_rgba(color_axis_labels.get_red(), color_axis_labels.get_green(), color_axis_labels.get_blue(),
-                       color_axis_labels.get_alpha());
+  Pango::FontDescription font;
+  font.set_family("Monospace");
+  font.set_weight(Pango::Weight::BOLD);
 
   /*
     we stop the loop at labels.size() - 1 because there is no space left in the window to show the last label. It
     would start to be drawn at the border of the window.
   */
 
-  for (size_t n = 0U; n < labels.size() - 1U; n++) {
+  for (size_t n = 0U; n + 1U < labels.size(); n++) {
     const auto& msg = Glib::ustring::format(std::setprecision(n_x_decimals), std::fixed, labels[n]) + " " + x_unit;
 
-    Pango::FontDescription font;
-    font.set_family("Monospace");
-    font.set_weight(Pango::Weight::BOLD);
-
     int text_width = 0;
     int text_height = 0;
 
@@ -272,14 +454,27 @@ auto Plot::draw_x_labels(const Cairo::RefPtr<Cairo::Context>& ctx, const int& wi
     layout->set_font_description(font);
     layout->get_pixel_size(text_width, text_height);
 
-    ctx->move_to(n * labels_offset, static_cast<double>(height - text_height));
+    x_labels_height = text_height;
 
-    layout->show_in_cairo_context(ctx);
+    x_labels.push_back(layout);
+  }
+}
 
-    if (n == labels.size() - 2U) {
-      return text_height;
-    }
+auto Plot::draw_x_labels(const Cairo::RefPtr<Cairo::Context>& ctx, const int& width, const int& height) -> int {
+  if (!x_labels_valid) {
+    build_x_labels();
+  }
+
+  const double labels_offset = width / static_cast<double>(n_x_labels);
+
+  ctx->set_source_rgba(color_axis_labels.get_red(), color_axis_labels.get_green(), color_axis_labels.get_blue(),
+                       color_axis_labels.get_alpha());
+
+  for (size_t n = 0U; n < x_labels.size(); n++) {
+    ctx->move_to(n * labels_offset, static_cast<double>(height - x_labels_height));
+
+    x_labels[n]->show_in_cairo_context(ctx);
   }
 
-  return 0;
+  return x_labels_height;
 }
@@ -63,6 +63,16 @@ void on_process(void* userdata, spa_io_position* position) {
 
     d->pb->process(left_in, right_in, left_out, right_out, l, r);
   }
+
+  /*
+    The plugin is still processed while the gate is closed. Otherwise its filters, envelopes and delay lines would keep
+    the state they had when the gate closed and it would be heard as a click when it opens again.
+  */
+
+  if (d->pb->vad_gate_closed.load(std::memory_order_relaxed)) {
+    std::ranges::fill(left_out, 0.0F);
+    std::ranges::fill(right_out, 0.0F);
+  }
 }
 
 const struct pw_filter_events filter_events = {.process = on_process};
@@ -82,6 +92,35 @@ PluginBase::PluginBase(std::string tag,
       pm(pipe_manager) {
   pf_data.pb = this;
 
+  /*
+    GSettings emits change-event once with all the keys of a transaction before it emits the changed signal of each
+    key. The lock is taken before the changed signals and released when all of them were handled.
+  */
+
+  change_event_handlers = {
+      g_signal_connect(settings->gobj(), "change-event", G_CALLBACK(on_change_event_begin), this),
+      g_signal_connect_after(settings->gobj(), "change-event", G_CALLBACK(on_change_event_end), this)};
+
+  parameters_settings = Gio::Settings::create(schema.c_str(), schema_path.c_str());
+
+  parameters_settings->delay();
+
+  settings->signal_changed().connect([this](const Glib::ustring& key) {
+    // a change made by someone else, like the window or a preset, wins over a value that was not written yet
+
+    if (const auto& it = pending_parameters.find(key.raw()); it != pending_parameters.end()) {
+      Glib::VariantBase current;
+
+      settings->get_value(key, current);
+
+      if (!current.equal(it->second)) {
+        pending_parameters.erase(it);
+      }
+    }
+
+    parameter_changed.emit(key.raw());
+  });
+
   const auto& filter_name = "pe_" + log_tag.substr(0, log_tag.size() - 2U) + "_" + name;
 
   pm->lock();
@@ -172,6 +211,33 @@ PluginBase::~PluginBase() {
   if (listener.link.next != nullptr || listener.link.prev != nullptr) {
     spa_hook_remove(&listener);
   }
+
+  parameters_apply_timeout.disconnect();
+
+  for (const auto& id : change_event_handlers) {
+    g_signal_handler_disconnect(settings->gobj(), id);
+  }
+
+  /*
+    Saving the parameters that were changed through the control interface and were not written yet. Our settings
+    object goes first so the handlers of the derived class, that is already destroyed, are not called for them.
+  */
+
+  settings.reset();
+
+  apply_pending_parameters();
+}
+
+auto PluginBase::on_change_event_begin(GSettings* settings, gpointer keys, gint n_keys, PluginBase* self) -> gboolean {
+  self->data_mutex.lock();
+
+  return FALSE;
+}
+
+auto PluginBase::on_change_event_end(GSettings* settings, gpointer keys, gint n_keys, PluginBase* self) -> gboolean {
+  self->data_mutex.unlock();
+
+  return FALSE;
 }
 
 auto PluginBase::connect_to_pw() -> bool {
@@ -226,6 +292,94 @@ void PluginBase::disconnect_from_pw() {
   pm->sync_wait_unlock();
 }
 
+auto PluginBase::set_parameter(const std::string& key, const Glib::VariantBase& value) -> bool {
+  const auto& schema = settings->property_settings_schema().get_value();
+
+  if (!schema->has_key(key)) {
+    util::warning(log_tag + name + ": unknown parameter: " + key);
+
+    return false;
+  }
+
+  const auto& schema_key = schema->get_key(key);
+
+  if (!value.is_of_type(schema_key->get_value_type()) || !schema_key->range_check(value)) {
+    util::warning(log_tag + name + ": invalid value for the parameter: " + key);
+
+    return false;
+  }
+
+  if (!set_realtime_parameter(key, value)) {
+    pending_parameters.erase(key);
+
+    settings->set_value(key, value);
+
+    return true;
+  }
+
+  pending_parameters.insert_or_assign(key, value);
+
+  parameter_changed.emit(key);
+
+  if (!parameters_apply_timeout.connected()) {
+    parameters_apply_timeout = Glib::signal_timeout().connect(
+        [this]() {
+          apply_pending_parameters();
+
+          return false;
+        },
+        parameters_apply_interval);
+  }
+
+  return true;
+}
+
+auto PluginBase::get_parameter(const std::string& key) const -> Glib::VariantBase {
+  if (const auto& it = pending_parameters.find(key); it != pending_parameters.end()) {
+    return it->second;
+  }
+
+  Glib::VariantBase value;
+
+  if (settings->property_settings_schema().get_value()->has_key(key)) {
+    settings->get_value(key, value);
+  }
+
+  return value;
+}
+
+auto PluginBase::set_realtime_parameter(const std::string& key, const Glib::VariantBase& value) -> bool {
+  if (key != "input-gain" && key != "output-gain") {
+    return false;
+  }
+
+  const auto& db = Glib::VariantBase::cast_dynamic<Glib::Variant<double>>(value).get();
+
+  if (key == "input-gain") {
+    input_gain = static_cast<float>(util::db_to_linear(db));
+  } else {
+    output_gain = static_cast<float>(util::db_to_linear(db));
+  }
+
+  return true;
+}
+
+void PluginBase::apply_pending_parameters() {
+  if (pending_parameters.empty()) {
+    return;
+  }
+
+  // the plugin is notified by the settings object. The values it gets are the ones it already has
+
+  for (const auto& [key, value] : pending_parameters) {
+    parameters_settings->set_value(key, value);
+  }
+
+  pending_parameters.clear();
+
+  parameters_settings->apply();
+}
+
 void PluginBase::setup() {}
 
 void PluginBase::process(std::span<float>& left_in,
@@ -270,11 +424,11 @@ void PluginBase::setup_input_output_gain() {
   output_gain = static_cast<float>(util::db_to_linear(settings->get_double("output-gain")));
 
   settings->signal_changed("input-gain").connect([=, this](const auto& key) {
-    input_gain = util::db_to_linear(settings->get_double(key));
+    input_gain = static_cast<float>(util::db_to_linear(settings->get_double(key)));
   });
 
   settings->signal_changed("output-gain").connect([=, this](const auto& key) {
-    output_gain = util::db_to_linear(settings->get_double(key));
+    output_gain = static_cast<float>(util::db_to_linear(settings->get_double(key)));
   });
 }
 
@@ -288,17 +442,34 @@ void PluginBase::apply_gain(std::span<float>& left, std::span<float>& right, con
 }
 
 void PluginBase::notify() {
-  const auto& input_peak_db_l = util::linear_to_db(input_peak_left);
-  const auto& input_peak_db_r = util::linear_to_db(input_peak_right);
+  input_level_db_left.store(util::linear_to_db(input_peak_left), std::memory_order_relaxed);
+  input_level_db_right.store(util::linear_to_db(input_peak_right), std::memory_order_relaxed);
 
-  const auto& output_peak_db_l = util::linear_to_db(output_peak_left);
-  const auto& output_peak_db_r = util::linear_to_db(output_peak_right);
+  output_level_db_left.store(util::linear_to_db(output_peak_left), std::memory_order_relaxed);
+  output_level_db_right.store(util::linear_to_db(output_peak_right), std::memory_order_relaxed);
 
-  Glib::signal_idle().connect_once([=, this] { input_level.emit(input_peak_db_l, input_peak_db_r); });
-  Glib::signal_idle().connect_once([=, this] { output_level.emit(output_peak_db_l, output_peak_db_r); });
+  // the plugin meter values written before this call are visible to the thread that sees this flag
+
+  meters_pending.store(true, std::memory_order_release);
 
   input_peak_left = util::minimum_linear_level;
   input_peak_right = util::minimum_linear_level;
   output_peak_left = util::minimum_linear_level;
   output_peak_right = util::minimum_linear_level;
 }
+
+void PluginBase::update_meters() {
+  if (!meters_pending.exchange(false, std::memory_order_acquire)) {
+    return;
+  }
+
+  input_level.emit(input_level_db_left.load(std::memory_order_relaxed),
+                   input_level_db_right.load(std::memory_order_relaxed));
+
+  output_level.emit(output_level_db_left.load(std::memory_order_relaxed),
+                    output_level_db_right.load(std::memory_order_relaxed));
+
+  emit_meters();
+}
+
+void PluginBase::emit_meters() {}
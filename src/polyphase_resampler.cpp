@@ -0,0 +1,206 @@
+/*
+ *  Copyright © 2017-2022 Wellington Wallace
+ *
+ *  This file is part of EasyEffects.
+ *
+ *  EasyEffects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  EasyEffects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with EasyEffects.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "polyphase_resampler.hpp"
+
+PolyphaseResampler::PolyphaseResampler(const uint& up,
+                                       const uint& down,
+                                       const uint& taps_per_phase,
+                                       const int& n_channels)
+    : up(up), down(down), channels(n_channels) {
+  // the taps are a multiple of 8 so the inner product can be split in 8 independent sums
+
+  taps = std::max(8U, (taps_per_phase + 7U) / 8U * 8U);
+
+  coefficients = get_coefficients(up, down, taps);
+
+  reset();
+}
+
+PolyphaseResampler::~PolyphaseResampler() = default;
+
+void PolyphaseResampler::reserve(const size_t& max_input_frames) {
+  for (auto& c : channels) {
+    c.buffer.reserve(taps - 1U + max_input_frames);
+  }
+}
+
+void PolyphaseResampler::reset() {
+  for (auto& c : channels) {
+    c.phase = 0U;
+    c.position = taps - 1U;
+
+    c.buffer.assign(taps - 1U, 0.0F);
+  }
+}
+
+auto PolyphaseResampler::get_output_frames(const size_t& input_frames) const -> size_t {
+  if (channels.empty()) {
+    return 0U;
+  }
+
+  const auto& c = channels[0];
+
+  const auto& available = c.buffer.size() + input_frames;
+
+  if (c.position >= available) {
+    return 0U;
+  }
+
+  /*
+    The output sample k reads up to the input sample position + (phase + k * down) / up. So it can be calculated if
+    phase + k * down < (available - position) * up.
+  */
+
+  return (static_cast<size_t>(up) * (available - c.position) - c.phase - 1U) / down + 1U;
+}
+
+auto PolyphaseResampler::get_latency() const -> float {
+  return 0.5F * static_cast<float>(up * taps - 1U) / static_cast<float>(up);
+}
+
+auto PolyphaseResampler::process(const int& channel,
+                                 std::span<const float> input,
+                                 std::span<float> output,
+                                 const size_t& stride) -> size_t {
+  auto& c = channels[channel];
+
+  // the spans of the channels after the first one in an interleaved buffer start at the channel offset
+
+  const auto& input_frames = (input.size() + stride - 1U) / stride;
+  const auto& output_frames = (output.size() + stride - 1U) / stride;
+
+  const auto& history = static_cast<size_t>(taps) - 1U;
+
+  // the buffer already holds the history. The new block goes after it
+
+  c.buffer.resize(history + input_frames);
+
+  for (size_t n = 0U; n < input_frames; n++) {
+    c.buffer[history + n] = input[n * stride];
+  }
+
+  const float* coeffs = coefficients->data();
+
+  size_t n_out = 0U;
+
+  while (c.position < c.buffer.size() && n_out < output_frames) {
+    output[n_out * stride] = inner_product(coeffs + c.phase * taps, c.buffer.data() + c.position - history);
+
+    n_out++;
+
+    c.phase += down;
+
+    c.position += c.phase / up;
+
+    c.phase %= up;
+  }
+
+  // keeping the last taps - 1 samples for the next block
+
+  const auto& consumed = c.buffer.size() - history;
+
+  std::copy(c.buffer.end() - static_cast<ptrdiff_t>(history), c.buffer.end(), c.buffer.begin());
+
+  c.buffer.resize(history);
+
+  c.position -= std::min(consumed, c.position - history);
+
+  return n_out;
+}
+
+auto PolyphaseResampler::inner_product(const float* coeffs, const float* samples) const -> float {
+  /*
+    Floating point sums can not be reordered by the compiler. With 8 independent partial sums the inner loop has no
+    dependency between iterations and it is turned into simd instructions.
+  */
+
+  std::array<float, 8U> sums{};
+
+  for (uint j = 0U; j < taps; j += 8U) {
+    for (uint k = 0U; k < 8U; k++) {
+      sums[k] += coeffs[j + k] * samples[j + k];
+    }
+  }
+
+  return ((sums[0] + sums[1]) + (sums[2] + sums[3])) + ((sums[4] + sums[5]) + (sums[6] + sums[7]));
+}
+
+auto PolyphaseResampler::get_coefficients(const uint& up, const uint& down, const uint& taps)
+    -> std::shared_ptr<const std::vector<float>> {
+  static std::mutex mutex;
+
+  static std::map<std::tuple<uint, uint, uint>, std::shared_ptr<const std::vector<float>>> cache;
+
+  std::scoped_lock<std::mutex> lock(mutex);
+
+  auto& entry = cache[{up, down, taps}];
+
+  if (entry == nullptr) {
+    entry = std::make_shared<const std::vector<float>>(create_coefficients(up, down, taps));
+  }
+
+  return entry;
+}
+
+auto PolyphaseResampler::create_coefficients(const uint& up, const uint& down, const uint& taps)
+    -> std::vector<float> {
+  /*
+    The prototype lowpass works at up times the input rate. Its cutoff is a little below the lowest Nyquist frequency
+    of the input and output rates. The kernel is a Blackman windowed-sinc https://www.dspguide.com/ch16/1.htm
+  */
+
+  const auto& size = static_cast<size_t>(up) * taps;
+
+  const double fc = 0.45 / static_cast<double>(std::max(up, down));
+
+  const double center = 0.5 * static_cast<double>(size - 1U);
+
+  std::vector<double> prototype(size);
+
+  for (size_t n = 0U; n < size; n++) {
+    const double x = static_cast<double>(n) - center;
+
+    const double sinc = (x == 0.0) ? 2.0 * fc : std::sin(2.0 * std::numbers::pi * fc * x) / (std::numbers::pi * x);
+
+    const double a = 2.0 * std::numbers::pi * static_cast<double>(n) / static_cast<double>(size - 1U);
+
+    const double w = 0.42 - 0.5 * std::cos(a) + 0.08 * std::cos(2.0 * a);
+
+    prototype[n] = sinc * w;
+  }
+
+  // each phase must have unity gain at dc
+
+  std::vector<float> output(size);
+
+  for (uint p = 0U; p < up; p++) {
+    double sum = 0.0;
+
+    for (uint j = 0U; j < taps; j++) {
+      sum += prototype[p + j * up];
+    }
+
+    for (uint j = 0U; j < taps; j++) {
+      output[p * taps + (taps - 1U - j)] = static_cast<float>(prototype[p + j * up] / sum);
+    }
+  }
+
+  return output;
+}
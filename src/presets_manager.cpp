@@ -81,10 +81,15 @@ PresetsManager::PresetsManager()
   create_user_directory(autoload_input_dir);
   create_user_directory(autoload_output_dir);
 
+  build_index(PresetType::input);
+  build_index(PresetType::output);
+
   user_output_monitor = Gio::File::create_for_path(user_output_dir.string())->monitor_directory();
 
   user_output_monitor->signal_changed().connect(
       [=, this](const Glib::RefPtr<Gio::File>& file, const auto& other_f, const auto& event) {
+        update_user_index(PresetType::output, file, event);
+
         switch (event) {
           case Gio::FileMonitor::Event::CREATED: {
             user_output_preset_created.emit(file);
@@ -103,6 +108,8 @@ PresetsManager::PresetsManager()
 
   user_input_monitor->signal_changed().connect(
       [=, this](const Glib::RefPtr<Gio::File>& file, const auto& other_f, const auto& event) {
+        update_user_index(PresetType::input, file, event);
+
         switch (event) {
           case Gio::FileMonitor::Event::CREATED: {
             user_input_preset_created.emit(file);
@@ -121,15 +128,13 @@ PresetsManager::PresetsManager()
 
   autoload_input_monitor->signal_changed().connect(
       [=, this](const Glib::RefPtr<Gio::File>& file, const auto& other_f, const auto& event) {
-        const auto& profiles = get_autoload_profiles(PresetType::input);
+        update_autoload_index(PresetType::input, file, event);
 
         switch (event) {
-          case Gio::FileMonitor::Event::CREATED: {
-            autoload_input_profiles_changed.emit(profiles);
-            break;
-          }
-          case Gio::FileMonitor::Event::DELETED: {
-            autoload_input_profiles_changed.emit(profiles);
+          case Gio::FileMonitor::Event::CREATED:
+          case Gio::FileMonitor::Event::DELETED:
+          case Gio::FileMonitor::Event::CHANGES_DONE_HINT: {
+            autoload_input_profiles_changed.emit(get_autoload_profiles(PresetType::input));
             break;
           }
           default:
@@ -141,15 +146,13 @@ PresetsManager::PresetsManager()
 
   autoload_output_monitor->signal_changed().connect(
       [=, this](const Glib::RefPtr<Gio::File>& file, const auto& other_f, const auto& event) {
-        const auto& profiles = get_autoload_profiles(PresetType::output);
+        update_autoload_index(PresetType::output, file, event);
 
         switch (event) {
-          case Gio::FileMonitor::Event::CREATED: {
-            autoload_output_profiles_changed.emit(profiles);
-            break;
-          }
-          case Gio::FileMonitor::Event::DELETED: {
-            autoload_output_profiles_changed.emit(profiles);
+          case Gio::FileMonitor::Event::CREATED:
+          case Gio::FileMonitor::Event::DELETED:
+          case Gio::FileMonitor::Event::CHANGES_DONE_HINT: {
+            autoload_output_profiles_changed.emit(get_autoload_profiles(PresetType::output));
             break;
           }
           default:
@@ -181,37 +184,210 @@ void PresetsManager::create_user_directory(const std::filesystem::path& path) {
   }
 }
 
-auto PresetsManager::get_names(const PresetType& preset_type) -> std::vector<Glib::ustring> {
-  std::filesystem::directory_iterator it;
-  std::vector<Glib::ustring> names;
+auto PresetsManager::get_index(const PresetType& preset_type) -> PresetIndex& {
+  return (preset_type == PresetType::output) ? output_index : input_index;
+}
 
-  // system directories search
-  std::vector<std::filesystem::path> sys_dirs;
+void PresetsManager::build_index(const PresetType& preset_type) {
+  auto& index = get_index(preset_type);
+
+  index = PresetIndex();
+
+  const auto& sys_dirs = (preset_type == PresetType::output) ? system_output_dir : system_input_dir;
+  const auto& user_dir = (preset_type == PresetType::output) ? user_output_dir : user_input_dir;
+  const auto& autoload_dir = (preset_type == PresetType::output) ? autoload_output_dir : autoload_input_dir;
+
+  // when the same preset name is in more than one system directory the first one wins like in load_preset_file
+
+  auto scan = [](const std::filesystem::path& dir, std::map<std::string, std::filesystem::path>& files) {
+    if (!std::filesystem::exists(dir)) {
+      return;
+    }
+
+    auto it = std::filesystem::directory_iterator{dir};
+
+    for (const auto& name : search_names(it)) {
+      files.try_emplace(name.raw(), dir / std::filesystem::path{name.raw() + json_ext});
+    }
+  };
+
+  for (const auto& dir : sys_dirs) {
+    scan(dir, index.system);
+  }
+
+  scan(user_dir, index.user);
+
+  try {
+    for (const auto& entry : std::filesystem::directory_iterator{autoload_dir}) {
+      if (entry.is_regular_file() && entry.path().extension().c_str() == json_ext) {
+        nlohmann::json json;
+
+        if (read_autoload_file(entry.path(), json)) {
+          index.autoload.insert_or_assign(entry.path().stem().string(), std::move(json));
+        }
+      }
+    }
+  } catch (const std::exception& e) {
+    util::warning(log_tag + e.what());
+  }
+
+  util::debug(log_tag + "indexed " + std::to_string(index.user.size() + index.system.size()) + " presets and " +
+              std::to_string(index.autoload.size()) + " autoload profiles");
+}
+
+void PresetsManager::update_user_index(const PresetType& preset_type,
+                                       const Glib::RefPtr<Gio::File>& file,
+                                       const Gio::FileMonitor::Event& event) {
+  const std::filesystem::path path{file->get_path()};
+
+  if (path.extension().c_str() != json_ext) {
+    return;
+  }
+
+  auto& index = get_index(preset_type);
+
+  switch (event) {
+    case Gio::FileMonitor::Event::CREATED: {
+      index.user.insert_or_assign(path.stem().string(), path);
 
-  switch (preset_type) {
-    case PresetType::output:
-      sys_dirs.insert(sys_dirs.end(), system_output_dir.begin(), system_output_dir.end());
       break;
-    case PresetType::input:
-      sys_dirs.insert(sys_dirs.end(), system_input_dir.begin(), system_input_dir.end());
+    }
+    case Gio::FileMonitor::Event::DELETED: {
+      index.user.erase(path.stem().string());
+
+      preset_cache.erase(path.string());
+
+      break;
+    }
+    case Gio::FileMonitor::Event::CHANGED:
+    case Gio::FileMonitor::Event::CHANGES_DONE_HINT: {
+      preset_cache.erase(path.string());
+
+      break;
+    }
+    default:
       break;
   }
+}
 
-  for (const auto& dir : sys_dirs) {
-    if (std::filesystem::exists(dir)) {
-      it = std::filesystem::directory_iterator{dir};
+void PresetsManager::update_autoload_index(const PresetType& preset_type,
+                                           const Glib::RefPtr<Gio::File>& file,
+                                           const Gio::FileMonitor::Event& event) {
+  const std::filesystem::path path{file->get_path()};
+
+  if (path.extension().c_str() != json_ext) {
+    return;
+  }
+
+  auto& index = get_index(preset_type);
+
+  switch (event) {
+    case Gio::FileMonitor::Event::CREATED:
+    case Gio::FileMonitor::Event::CHANGES_DONE_HINT: {
+      // a file that is still being written may not be valid yet. The previous entry is kept until it is
+
+      nlohmann::json json;
 
-      const auto& vn = search_names(it);
-      names.insert(names.end(), vn.begin(), vn.end());
+      if (read_autoload_file(path, json)) {
+        index.autoload.insert_or_assign(path.stem().string(), std::move(json));
+      }
+
+      break;
     }
+    case Gio::FileMonitor::Event::DELETED: {
+      index.autoload.erase(path.stem().string());
+
+      break;
+    }
+    default:
+      break;
   }
+}
 
-  // user directory search
-  const auto& user_dir = (preset_type == PresetType::output) ? user_output_dir : user_input_dir;
-  it = std::filesystem::directory_iterator{user_dir};
+auto PresetsManager::read_autoload_file(const std::filesystem::path& path, nlohmann::json& json) -> bool {
+  try {
+    std::ifstream is(path);
+
+    is >> json;
+
+    return true;
+  } catch (const nlohmann::json::exception& e) {
+    util::warning(log_tag + path.string() + ": " + e.what());
+
+    return false;
+  }
+}
+
+auto PresetsManager::find_preset_file(const PresetType& preset_type, const Glib::ustring& name)
+    -> std::filesystem::path {
+  const auto& index = get_index(preset_type);
+
+  // user presets have priority over the system ones
+
+  if (const auto& it = index.user.find(name.raw()); it != index.user.end()) {
+    return it->second;
+  }
+
+  if (const auto& it = index.system.find(name.raw()); it != index.system.end()) {
+    return it->second;
+  }
+
+  return {};
+}
+
+auto PresetsManager::get_preset_json(const std::filesystem::path& path) -> std::shared_ptr<const nlohmann::json> {
+  std::error_code ec;
 
-  const auto& vn = search_names(it);
-  names.insert(names.end(), vn.begin(), vn.end());
+  const auto& mtime = std::filesystem::last_write_time(path, ec);
+
+  if (ec) {
+    preset_cache.erase(path.string());
+
+    return nullptr;
+  }
+
+  /*
+    The file monitor already drops the entries of modified user presets. Comparing the modification time also covers
+    the system presets and the events we may not have received yet.
+  */
+
+  if (const auto& it = preset_cache.find(path.string()); it != preset_cache.end() && it->second.mtime == mtime) {
+    return it->second.json;
+  }
+
+  auto json = std::make_shared<nlohmann::json>();
+
+  try {
+    std::ifstream is(path);
+
+    is >> *json;
+  } catch (const nlohmann::json::exception& e) {
+    preset_cache.erase(path.string());
+
+    util::warning(log_tag + e.what());
+
+    return nullptr;
+  }
+
+  preset_cache.insert_or_assign(path.string(), CachedPreset{mtime, json});
+
+  return json;
+}
+
+auto PresetsManager::get_names(const PresetType& preset_type) -> std::vector<Glib::ustring> {
+  const auto& index = get_index(preset_type);
+
+  std::vector<Glib::ustring> names;
+
+  names.reserve(index.system.size() + index.user.size());
+
+  for (const auto& [name, path] : index.system) {
+    names.emplace_back(name);
+  }
+
+  for (const auto& [name, path] : index.user) {
+    names.emplace_back(name);
+  }
 
   // removing duplicates
   std::sort(names.begin(), names.end());
@@ -241,10 +417,8 @@ auto PresetsManager::search_names(std::filesystem::directory_iterator& it) -> st
 }
 
 void PresetsManager::add(const PresetType& preset_type, const Glib::ustring& name) {
-  for (const auto& p : get_names(preset_type)) {
-    if (p == name) {
-      return;
-    }
+  if (preset_file_exists(preset_type, name)) {
+    return;
   }
 
   save_preset_file(preset_type, name);
@@ -366,6 +540,10 @@ void PresetsManager::save_preset_file(const PresetType& preset_type, const Glib:
 
   // std::cout << std::setw(4) << json << std::endl;
 
+  get_index(preset_type).user.insert_or_assign(name.raw(), output_file);
+
+  preset_cache.erase(output_file.string());
+
   util::debug(log_tag + "saved preset: " + output_file.string());
 }
 
@@ -433,115 +611,71 @@ void PresetsManager::remove(const PresetType& preset_type, const Glib::ustring&
   if (std::filesystem::exists(preset_file)) {
     std::filesystem::remove(preset_file);
 
+    get_index(preset_type).user.erase(name.raw());
+
+    preset_cache.erase(preset_file.string());
+
     util::debug(log_tag + "removed preset: " + preset_file.string());
   }
 }
 
 void PresetsManager::load_preset_file(const PresetType& preset_type, const Glib::ustring& name) {
-  nlohmann::json json;
+  if (preset_transition != nullptr && !find_preset_file(preset_type, name).empty()) {
+    preset_transition(preset_type, [=, this]() { apply_preset_file(preset_type, name); });
 
-  std::vector<Glib::ustring> plugins;
-
-  std::vector<std::filesystem::path> conf_dirs;
-
-  std::filesystem::path input_file;
+    return;
+  }
 
-  auto preset_found = false;
+  apply_preset_file(preset_type, name);
+}
 
-  switch (preset_type) {
-    case PresetType::output: {
-      conf_dirs.push_back(user_output_dir);
+void PresetsManager::apply_preset_file(const PresetType& preset_type, const Glib::ustring& name) {
+  std::vector<Glib::ustring> plugins;
 
-      conf_dirs.insert(conf_dirs.end(), system_output_dir.begin(), system_output_dir.end());
+  const auto& input_file = find_preset_file(preset_type, name);
 
-      for (const auto& dir : conf_dirs) {
-        input_file = dir / std::filesystem::path{name.c_str() + json_ext};
+  std::shared_ptr<const nlohmann::json> json;
 
-        if (std::filesystem::exists(input_file)) {
-          preset_found = true;
+  if (!input_file.empty()) {
+    json = get_preset_json(input_file);
 
-          break;
-        }
-      }
+    const auto& section = (preset_type == PresetType::output) ? "output" : "input";
 
-      if (preset_found) {
-        try {
-          std::ifstream is(input_file);
-
-          is >> json;
-
-          for (const auto& p : json.at("output").at("plugins_order").get<std::vector<std::string>>()) {
-            for (const auto& v : plugin_name::list) {
-              if (v == p) {
-                plugins.push_back(p);
+    if (json != nullptr) {
+      try {
+        for (const auto& p : json->at(section).at("plugins_order").get<std::vector<std::string>>()) {
+          for (const auto& v : plugin_name::list) {
+            if (v == p) {
+              plugins.push_back(p);
 
-                break;
-              }
+              break;
             }
           }
-
-        } catch (const nlohmann::json::exception& e) {
-          plugins.clear();
-
-          util::warning(log_tag + e.what());
         }
 
-        soe_settings->set_string_array("plugins", plugins);
-      } else {
-        util::debug("can't find the preset " + name + " on the filesystem");
-      }
-
-      break;
-    }
-    case PresetType::input: {
-      conf_dirs.push_back(user_input_dir);
-
-      conf_dirs.insert(conf_dirs.end(), system_input_dir.begin(), system_input_dir.end());
-
-      for (const auto& dir : conf_dirs) {
-        input_file = dir / std::filesystem::path{name.c_str() + json_ext};
-
-        if (std::filesystem::exists(input_file)) {
-          preset_found = true;
+      } catch (const nlohmann::json::exception& e) {
+        plugins.clear();
 
-          break;
-        }
+        util::warning(log_tag + e.what());
       }
+    }
 
-      if (preset_found) {
-        try {
-          std::ifstream is(input_file);
-
-          is >> json;
-
-          for (const auto& p : json.at("input").at("plugins_order").get<std::vector<std::string>>()) {
-            for (const auto& v : plugin_name::list) {
-              if (v == p) {
-                plugins.push_back(p);
-
-                break;
-              }
-            }
-          }
-
-        } catch (const nlohmann::json::exception& e) {
-          plugins.clear();
-
-          util::warning(log_tag + e.what());
-        }
+    const auto& stream_settings = (preset_type == PresetType::output) ? soe_settings : sie_settings;
 
-        sie_settings->set_string_array("plugins", plugins);
-      } else {
-        util::debug("can't find the preset " + name + " on the filesystem");
-      }
-
-      break;
+    if (stream_settings->get_string_array("plugins") != plugins) {
+      stream_settings->set_string_array("plugins", plugins);
     }
+  } else {
+    util::debug("can't find the preset " + name + " on the filesystem");
   }
 
-  load_blocklist(preset_type, json);
+  if (json == nullptr) {
+    json = std::make_shared<const nlohmann::json>();
+  }
+
+  load_blocklist(preset_type, *json);
 
-  read_plugins_preset(preset_type, plugins, json);
+  read_plugins_preset(preset_type, plugins, *json);
 
   util::debug(log_tag + "loaded preset: " + input_file.string());
 }
@@ -613,6 +747,10 @@ void PresetsManager::import(const PresetType& preset_type, const std::string& fi
 
       std::filesystem::copy_file(p, out_path, std::filesystem::copy_options::overwrite_existing);
 
+      get_index(preset_type).user.insert_or_assign(p.stem().string(), out_path);
+
+      preset_cache.erase(out_path.string());
+
       util::debug(log_tag + "imported preset to: " + out_path.string());
     }
   } else {
@@ -645,6 +783,8 @@ void PresetsManager::add_autoload(const PresetType& preset_type,
 
   o << std::setw(4) << json << std::endl;
 
+  get_index(preset_type).autoload.insert_or_assign(device_name + ":" + device_profile, json);
+
   util::debug(log_tag + "added autoload preset file: " + output_file.string());
 }
 
@@ -663,43 +803,32 @@ void PresetsManager::remove_autoload(const PresetType& preset_type,
       break;
   }
 
-  if (std::filesystem::is_regular_file(input_file)) {
-    nlohmann::json json;
+  auto& index = get_index(preset_type);
 
-    std::ifstream is(input_file);
+  const auto& it = index.autoload.find(device_name + ":" + device_profile);
 
-    is >> json;
+  if (it == index.autoload.end()) {
+    return;
+  }
 
-    if (preset_name == json.value("preset-name", "") && device_profile == json.value("device-profile", "")) {
-      std::filesystem::remove(input_file);
+  const auto& json = it->second;
 
-      util::debug(log_tag + "removed autoload: " + input_file.string());
-    }
+  if (preset_name == json.value("preset-name", "") && device_profile == json.value("device-profile", "")) {
+    std::filesystem::remove(input_file);
+
+    index.autoload.erase(it);
+
+    util::debug(log_tag + "removed autoload: " + input_file.string());
   }
 }
 
 auto PresetsManager::find_autoload(const PresetType& preset_type,
                                    const std::string& device_name,
                                    const std::string& device_profile) -> Glib::ustring {
-  std::filesystem::path input_file;
+  const auto& index = get_index(preset_type);
 
-  switch (preset_type) {
-    case PresetType::output:
-      input_file = autoload_output_dir / std::filesystem::path{device_name + ":" + device_profile + json_ext};
-      break;
-    case PresetType::input:
-      input_file = autoload_input_dir / std::filesystem::path{device_name + ":" + device_profile + json_ext};
-      break;
-  }
-
-  if (std::filesystem::is_regular_file(input_file)) {
-    nlohmann::json json;
-
-    std::ifstream is(input_file);
-
-    is >> json;
-
-    return json.value("preset-name", "");
+  if (const auto& it = index.autoload.find(device_name + ":" + device_profile); it != index.autoload.end()) {
+    return it->second.value("preset-name", "");
   }
 
   return "";
@@ -727,82 +856,19 @@ void PresetsManager::autoload(const PresetType& preset_type,
 }
 
 auto PresetsManager::get_autoload_profiles(const PresetType& preset_type) -> std::vector<nlohmann::json> {
-  std::filesystem::path autoload_dir;
+  const auto& index = get_index(preset_type);
+
   std::vector<nlohmann::json> list;
 
-  switch (preset_type) {
-    case PresetType::output:
-      autoload_dir = autoload_output_dir;
+  list.reserve(index.autoload.size());
 
-      break;
-    case PresetType::input:
-      autoload_dir = autoload_input_dir;
-      break;
+  for (const auto& [key, json] : index.autoload) {
+    list.push_back(json);
   }
 
-  auto it = std::filesystem::directory_iterator{autoload_dir};
-
-  try {
-    while (it != std::filesystem::directory_iterator{}) {
-      if (std::filesystem::is_regular_file(it->status())) {
-        if (it->path().extension().c_str() == json_ext) {
-          nlohmann::json json;
-
-          std::ifstream is(autoload_dir / it->path());
-
-          is >> json;
-
-          list.push_back(json);
-        }
-      }
-
-      ++it;
-    }
-
-    return list;
-  } catch (const std::exception& e) {
-    util::warning(log_tag + e.what());
-
-    return list;
-  }
+  return list;
 }
 
 auto PresetsManager::preset_file_exists(const PresetType& preset_type, const Glib::ustring& name) -> bool {
-  std::filesystem::path input_file;
-  std::vector<std::filesystem::path> conf_dirs;
-
-  switch (preset_type) {
-    case PresetType::output: {
-      conf_dirs.push_back(user_output_dir);
-
-      conf_dirs.insert(conf_dirs.end(), system_output_dir.begin(), system_output_dir.end());
-
-      for (const auto& dir : conf_dirs) {
-        input_file = dir / std::filesystem::path{name.c_str() + json_ext};
-
-        if (std::filesystem::exists(input_file)) {
-          return true;
-        }
-      }
-
-      break;
-    }
-    case PresetType::input: {
-      conf_dirs.push_back(user_input_dir);
-
-      conf_dirs.insert(conf_dirs.end(), system_input_dir.begin(), system_input_dir.end());
-
-      for (const auto& dir : conf_dirs) {
-        input_file = dir / std::filesystem::path{name.c_str() + json_ext};
-
-        if (std::filesystem::exists(input_file)) {
-          return true;
-        }
-      }
-
-      break;
-    }
-  }
-
-  return false;
+  return !find_preset_file(preset_type, name).empty();
 }
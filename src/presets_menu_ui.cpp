@@ -91,7 +91,7 @@ PresetsMenuUi::PresetsMenuUi(BaseObjectType* cobject,
     last_used_input->set_label(settings->get_string("last-used-input-preset"));
   });
 
-  app->presets_manager->user_output_preset_created.connect([=, this](const Glib::RefPtr<Gio::File>& file) {
+  app->core->presets_manager->user_output_preset_created.connect([=, this](const Glib::RefPtr<Gio::File>& file) {
     const auto& preset_name = util::remove_filename_extension(file->get_basename());
 
     if (preset_name.empty()) {
@@ -109,7 +109,7 @@ PresetsMenuUi::PresetsMenuUi(BaseObjectType* cobject,
     output_string_list->append(preset_name);
   });
 
-  app->presets_manager->user_output_preset_removed.connect([=, this](const Glib::RefPtr<Gio::File>& file) {
+  app->core->presets_manager->user_output_preset_removed.connect([=, this](const Glib::RefPtr<Gio::File>& file) {
     const auto& preset_name = util::remove_filename_extension(file->get_basename());
 
     if (preset_name.empty()) {
@@ -127,7 +127,7 @@ PresetsMenuUi::PresetsMenuUi(BaseObjectType* cobject,
     }
   });
 
-  app->presets_manager->user_input_preset_created.connect([=, this](const Glib::RefPtr<Gio::File>& file) {
+  app->core->presets_manager->user_input_preset_created.connect([=, this](const Glib::RefPtr<Gio::File>& file) {
     const auto& preset_name = util::remove_filename_extension(file->get_basename());
 
     if (preset_name.empty()) {
@@ -145,7 +145,7 @@ PresetsMenuUi::PresetsMenuUi(BaseObjectType* cobject,
     input_string_list->append(preset_name);
   });
 
-  app->presets_manager->user_input_preset_removed.connect([=, this](const Glib::RefPtr<Gio::File>& file) {
+  app->core->presets_manager->user_input_preset_removed.connect([=, this](const Glib::RefPtr<Gio::File>& file) {
     const auto& preset_name = util::remove_filename_extension(file->get_basename());
 
     if (preset_name.empty()) {
@@ -220,7 +220,7 @@ void PresetsMenuUi::create_preset(PresetType preset_type) {
     return;
   }
 
-  app->presets_manager->add(preset_type, name);
+  app->core->presets_manager->add(preset_type, name);
 }
 
 void PresetsMenuUi::import_preset(PresetType preset_type) {
@@ -239,7 +239,7 @@ void PresetsMenuUi::import_preset(PresetType preset_type) {
   dialog->signal_response().connect([=, this](const auto& response_id) {
     switch (response_id) {
       case Gtk::ResponseType::ACCEPT: {
-        app->presets_manager->import(preset_type, dialog->get_file()->get_path());
+        app->core->presets_manager->import(preset_type, dialog->get_file()->get_path());
 
         break;
       }
@@ -257,7 +257,7 @@ void PresetsMenuUi::setup_listview(Gtk::ListView* listview,
                                    Glib::RefPtr<Gtk::StringList>& string_list) {
   string_list->remove(0);
 
-  for (const auto& name : app->presets_manager->get_names(preset_type)) {
+  for (const auto& name : app->core->presets_manager->get_names(preset_type)) {
     string_list->append(name);
   }
 
@@ -331,14 +331,14 @@ void PresetsMenuUi::setup_listview(Gtk::ListView* listview,
           break;
       }
 
-      app->presets_manager->load_preset_file(preset_type, name);
+      app->core->presets_manager->load_preset_file(preset_type, name);
     });
 
-    auto connection_save =
-        save->signal_clicked().connect([=, this]() { app->presets_manager->save_preset_file(preset_type, name); });
+    auto connection_save = save->signal_clicked().connect(
+        [=, this]() { app->core->presets_manager->save_preset_file(preset_type, name); });
 
     auto connection_remove =
-        remove->signal_clicked().connect([=, this]() { app->presets_manager->remove(preset_type, name); });
+        remove->signal_clicked().connect([=, this]() { app->core->presets_manager->remove(preset_type, name); });
 
     list_item->set_data("connection_apply", new sigc::connection(connection_apply),
                         Glib::destroy_notify_delete<sigc::connection>);
@@ -362,8 +362,8 @@ void PresetsMenuUi::setup_listview(Gtk::ListView* listview,
 }
 
 void PresetsMenuUi::reset_menu_button_label() {
-  const auto& names_input = app->presets_manager->get_names(PresetType::input);
-  const auto& names_output = app->presets_manager->get_names(PresetType::output);
+  const auto& names_input = app->core->presets_manager->get_names(PresetType::input);
+  const auto& names_output = app->core->presets_manager->get_names(PresetType::output);
 
   if (names_input.empty() && names_output.empty()) {
     settings->set_string("last-used-output-preset", _("Presets"));
@@ -19,10 +19,66 @@
 
 #include "resampler.hpp"
 
-Resampler::Resampler(const int& input_rate, const int& output_rate) : output(1, 0) {
-  resample_ratio = static_cast<float>(output_rate) / static_cast<float>(input_rate);
+namespace {
 
-  src_state = src_new(SRC_SINC_FASTEST, 1, nullptr);
+auto converter_type(const ResamplerQuality& quality) -> int {
+  switch (quality) {
+    case ResamplerQuality::best:
+      return SRC_SINC_BEST_QUALITY;
+
+    case ResamplerQuality::medium:
+      return SRC_SINC_MEDIUM_QUALITY;
+
+    default:
+      return SRC_SINC_FASTEST;
+  }
+}
+
+auto polyphase_taps(const ResamplerQuality& quality) -> uint {
+  switch (quality) {
+    case ResamplerQuality::best:
+      return 64U;
+
+    case ResamplerQuality::medium:
+      return 48U;
+
+    default:
+      return 32U;
+  }
+}
+
+}  // namespace
+
+Resampler::Resampler(const int& input_rate,
+                     const int& output_rate,
+                     const int& n_channels,
+                     const ResamplerQuality& quality)
+    : n_channels(n_channels) {
+  resample_ratio = static_cast<double>(output_rate) / static_cast<double>(input_rate);
+
+  const auto& divisor = std::gcd(input_rate, output_rate);
+
+  const auto& up = static_cast<uint>(output_rate / divisor);
+  const auto& down = static_cast<uint>(input_rate / divisor);
+
+  if (up <= PolyphaseResampler::max_ratio_term && down <= PolyphaseResampler::max_ratio_term) {
+    // when downsampling the filter is proportionally longer so its transition band stays as sharp
+
+    const auto& taps = (polyphase_taps(quality) * std::max(up, down) + up - 1U) / up;
+
+    polyphase = std::make_unique<PolyphaseResampler>(up, down, taps, n_channels);
+
+    return;
+  }
+
+  int error = 0;
+
+  src_state = src_new(converter_type(quality), n_channels, &error);
+
+  if (src_state == nullptr) {
+    util::warning("resampler: could not create the converter: " + std::string(src_strerror(error)) +
+                  ". The audio will not be resampled");
+  }
 }
 
 Resampler::~Resampler() {
@@ -30,3 +86,178 @@ Resampler::~Resampler() {
     src_delete(src_state);
   }
 }
+
+auto Resampler::get_max_output_frames(const size_t& input_frames) const -> size_t {
+  return static_cast<size_t>(std::ceil(resample_ratio * static_cast<double>(input_frames))) + 2U;
+}
+
+void Resampler::reserve(const size_t& max_input_frames) {
+  if (polyphase != nullptr) {
+    polyphase->reserve(max_input_frames);
+
+    return;
+  }
+
+  if (n_channels != 2) {
+    return;
+  }
+
+  interleaved_input.resize(2U * max_input_frames);
+  interleaved_output.resize(2U * get_max_output_frames(max_input_frames));
+}
+
+void Resampler::reset() {
+  if (polyphase != nullptr) {
+    polyphase->reset();
+  }
+
+  if (src_state != nullptr) {
+    src_reset(src_state);
+  }
+}
+
+auto Resampler::process(std::span<const float> input, std::span<float> output, const bool& end_of_input) -> size_t {
+  const auto& channels = static_cast<size_t>(n_channels);
+
+  if (polyphase != nullptr) {
+    size_t frames_generated = 0U;
+
+    for (size_t c = 0U; c < channels && c < input.size() && c < output.size(); c++) {
+      frames_generated = polyphase->process(static_cast<int>(c), input.subspan(c), output.subspan(c), channels);
+    }
+
+    return frames_generated;
+  }
+
+  // without a converter the input is copied unchanged. It is better than dropping the audio
+
+  if (src_state == nullptr) {
+    const auto frames = std::min(input.size(), output.size()) / channels;
+
+    std::copy(input.begin(), input.begin() + static_cast<ptrdiff_t>(frames * channels), output.begin());
+
+    return frames;
+  }
+
+  size_t frames_used = 0U;
+  size_t frames_generated = 0U;
+
+  /*
+    A single call is enough when the output has room for get_max_output_frames. The loop only matters when the
+    converter is flushing its filter at the end of the input.
+  */
+
+  do {
+    src_data.data_in = input.data() + frames_used * channels;
+    src_data.input_frames = static_cast<long>(input.size() / channels - frames_used);
+
+    src_data.data_out = output.data() + frames_generated * channels;
+    src_data.output_frames = static_cast<long>(output.size() / channels - frames_generated);
+
+    src_data.src_ratio = resample_ratio;
+    src_data.end_of_input = static_cast<int>(end_of_input);
+
+    if (src_process(src_state, &src_data) != 0) {
+      break;
+    }
+
+    frames_used += static_cast<size_t>(src_data.input_frames_used);
+    frames_generated += static_cast<size_t>(src_data.output_frames_gen);
+  } while (src_data.output_frames_gen > 0 && frames_generated < output.size() / channels &&
+           (frames_used < input.size() / channels || end_of_input));
+
+  return frames_generated;
+}
+
+auto Resampler::process(std::span<const float> input_left,
+                        std::span<const float> input_right,
+                        std::span<float> output_left,
+                        std::span<float> output_right,
+                        const bool& end_of_input) -> size_t {
+  const auto input_frames = std::min(input_left.size(), input_right.size());
+  const auto output_frames = std::min(output_left.size(), output_right.size());
+
+  // the polyphase filter works on each channel separately. There is no need to interleave them
+
+  if (polyphase != nullptr) {
+    polyphase->process(0, input_left.first(input_frames), output_left.first(output_frames));
+
+    return polyphase->process(1, input_right.first(input_frames), output_right.first(output_frames));
+  }
+
+  // blocks larger than the reserved size are still processed. But this is the only case where we allocate
+
+  if (interleaved_input.size() < 2U * input_frames) {
+    interleaved_input.resize(2U * input_frames);
+  }
+
+  if (interleaved_output.size() < 2U * output_frames) {
+    interleaved_output.resize(2U * output_frames);
+  }
+
+  for (size_t n = 0U; n < input_frames; n++) {
+    interleaved_input[2U * n] = input_left[n];
+    interleaved_input[2U * n + 1U] = input_right[n];
+  }
+
+  const auto frames_generated =
+      process(std::span<const float>(interleaved_input.data(), 2U * input_frames),
+              std::span<float>(interleaved_output.data(), 2U * output_frames), end_of_input);
+
+  for (size_t n = 0U; n < frames_generated; n++) {
+    output_left[n] = interleaved_output[2U * n];
+    output_right[n] = interleaved_output[2U * n + 1U];
+  }
+
+  return frames_generated;
+}
+
+auto Resampler::process(const std::vector<float>& input, const bool& end_of_input) -> std::vector<float> {
+  const auto& channels = static_cast<size_t>(n_channels);
+
+  if (polyphase != nullptr && end_of_input) {
+    /*
+      The input is padded with zeros so the samples still inside the filter come out. Then the filter delay is removed
+      so the output is aligned with the input as it is when libsamplerate is used.
+    */
+
+    const auto& input_frames = input.size() / channels;
+
+    const auto& padding = static_cast<size_t>(std::ceil(polyphase->get_latency())) + 1U;
+
+    const auto& delay = static_cast<size_t>(std::lround(polyphase->get_latency() * resample_ratio));
+
+    const auto& expected_frames = static_cast<size_t>(std::lround(resample_ratio * static_cast<double>(input_frames)));
+
+    std::vector<float> padded_input(input);
+
+    padded_input.resize(channels * (input_frames + padding), 0.0F);
+
+    std::vector<float> output(channels * get_max_output_frames(input_frames + padding));
+
+    const auto& frames_generated = process(std::span<const float>(padded_input), std::span<float>(output), false);
+
+    if (frames_generated <= delay) {
+      return {};
+    }
+
+    output.resize(channels * std::min(frames_generated, delay + expected_frames));
+
+    output.erase(output.begin(), output.begin() + static_cast<ptrdiff_t>(channels * delay));
+
+    return output;
+  }
+
+  /*
+    When the input ends the converter also flushes the samples that were still inside its filter. The extra room
+    covers the longest filter we use.
+  */
+
+  std::vector<float> output(channels * (get_max_output_frames(input.size() / channels) + (end_of_input ? 1024U : 0U)));
+
+  const auto& frames_generated = process(std::span<const float>(input), std::span<float>(output), end_of_input);
+
+  output.resize(channels * frames_generated);
+
+  return output;
+}
@@ -101,3 +101,7 @@ void Reverb::process(std::span<float>& left_in,
     }
   }
 }
+
+auto Reverb::set_realtime_parameter(const std::string& key, const Glib::VariantBase& value) -> bool {
+  return PluginBase::set_realtime_parameter(key, value) || lv2_wrapper->set_bound_key(settings, key, value);
+}
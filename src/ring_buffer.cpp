@@ -0,0 +1,90 @@
+/*
+ *  Copyright © 2017-2022 Wellington Wallace
+ *
+ *  This file is part of EasyEffects.
+ *
+ *  EasyEffects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  EasyEffects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with EasyEffects.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ring_buffer.hpp"
+
+void RingBuffer::resize(const size_t& capacity) {
+  size_t size = 1U;
+
+  while (size < capacity) {
+    size *= 2U;
+  }
+
+  buffer.resize(size);
+
+  mask = size - 1U;
+
+  reset();
+}
+
+void RingBuffer::reset() {
+  read_index.store(0U);
+  write_index.store(0U);
+}
+
+auto RingBuffer::capacity() const -> size_t {
+  return buffer.size();
+}
+
+auto RingBuffer::read_available() const -> size_t {
+  return write_index.load(std::memory_order_acquire) - read_index.load(std::memory_order_acquire);
+}
+
+auto RingBuffer::write_available() const -> size_t {
+  return buffer.size() - read_available();
+}
+
+auto RingBuffer::push(std::span<const float> data) -> size_t {
+  const auto& w = write_index.load(std::memory_order_relaxed);
+  const auto& r = read_index.load(std::memory_order_acquire);
+
+  const auto count = std::min(data.size(), buffer.size() - (w - r));
+
+  /*
+    The indexes grow without wrapping and are masked only when the buffer is accessed. This way a full buffer can be
+    told apart from an empty one. The copy is split in two when it crosses the end of the buffer.
+  */
+
+  const auto& start = w & mask;
+  const auto first = std::min(count, buffer.size() - start);
+
+  std::copy(data.begin(), data.begin() + first, buffer.begin() + start);
+  std::copy(data.begin() + first, data.begin() + count, buffer.begin());
+
+  write_index.store(w + count, std::memory_order_release);
+
+  return count;
+}
+
+auto RingBuffer::pop(std::span<float> data) -> size_t {
+  const auto& r = read_index.load(std::memory_order_relaxed);
+  const auto& w = write_index.load(std::memory_order_acquire);
+
+  const auto count = std::min(data.size(), w - r);
+
+  const auto& start = r & mask;
+  const auto first = std::min(count, buffer.size() - start);
+
+  std::copy(buffer.begin() + start, buffer.begin() + start + first, data.begin());
+  std::copy(buffer.begin(), buffer.begin() + (count - first), data.begin() + first);
+
+  read_index.store(r + count, std::memory_order_release);
+
+  return count;
+}
@@ -19,6 +19,21 @@
 
 #include "rnnoise.hpp"
 
+namespace {
+
+constexpr auto RIGHT_WORKER_SCHEDULER_CLASS = SCHED_FIFO;
+
+/*
+  Models loaded by any RNNoise instance. The input and output pipelines usually use the same file. An entry is only
+  reused if the file was not modified after it was loaded. The cache does not keep the models alive.
+*/
+
+std::mutex model_cache_mutex;
+
+std::map<std::string, std::pair<std::filesystem::file_time_type, std::weak_ptr<RNNModel>>> model_cache;
+
+}  // namespace
+
 RNNoise::RNNoise(const std::string& tag,
                  const std::string& schema,
                  const std::string& schema_path,
@@ -28,34 +43,29 @@ RNNoise::RNNoise(const std::string& tag,
   data_R.reserve(blocksize);
 
   settings->signal_changed("model-path").connect([=, this](const auto& key) {
-    data_mutex.lock();
-
-    rnnoise_ready = false;
-
-    data_mutex.unlock();
-
-    free_rnnoise();
+    const auto path = settings->get_string(key).raw();
 
-    auto* m = get_model_from_file();
+    /*
+      A load that is still running is finished before this one starts. It locks data_mutex when it is done. So we wait
+      for it only after the current settings transaction released the lock.
+    */
 
-    model = m;
+    Glib::signal_idle().connect_once([=, this] { model_loader = std::jthread([=, this] { load_model(path); }); });
+  });
 
-    state_left = rnnoise_create(model);
-    state_right = rnnoise_create(model);
+  settings->signal_changed("channel-mode").connect([=, this](const auto& key) { update_channel_mode(); });
 
-    rnnoise_ready = true;
-  });
+  for (const auto* key : {"vad-gate", "vad-threshold", "vad-hangover"}) {
+    settings->signal_changed(key).connect([=, this](const auto& key) { update_vad_settings(); });
+  }
 
   setup_input_output_gain();
 
-  auto* m = get_model_from_file();
-
-  model = m;
+  update_channel_mode();
 
-  state_left = rnnoise_create(model);
-  state_right = rnnoise_create(model);
+  update_vad_settings();
 
-  rnnoise_ready = true;
+  load_model(settings->get_string("model-path").raw());
 }
 
 RNNoise::~RNNoise() {
@@ -63,17 +73,29 @@ RNNoise::~RNNoise() {
     disconnect_from_pw();
   }
 
-  std::scoped_lock<std::mutex> lock(data_mutex);
+  // the loader locks data_mutex when it is done
+
+  if (model_loader.joinable()) {
+    model_loader.join();
+  }
+
+  std::scoped_lock<std::recursive_mutex> lock(data_mutex);
 
   resampler_ready = false;
 
+  stop_right_worker();
+
+  // the other plugins may already be gone
+
+  vad_gated_plugins.clear();
+
   free_rnnoise();
 
   util::debug(log_tag + name + " destroyed");
 }
 
 void RNNoise::setup() {
-  std::scoped_lock<std::mutex> lock(data_mutex);
+  std::scoped_lock<std::recursive_mutex> lock(data_mutex);
 
   resampler_ready = false;
 
@@ -87,11 +109,28 @@ void RNNoise::setup() {
   deque_out_L.resize(0);
   deque_out_R.resize(0);
 
-  resampler_inL = std::make_unique<Resampler>(rate, rnnoise_rate);
-  resampler_inR = std::make_unique<Resampler>(rate, rnnoise_rate);
+  resampler_in = std::make_unique<Resampler>(rate, rnnoise_rate, 2);
+  resampler_out = std::make_unique<Resampler>(rnnoise_rate, rate, 2);
+
+  /*
+    remove_noise only returns whole rnnoise blocks. So the output resampler may receive up to one block more than
+    what the input resampler generated. With the buffers allocated here nothing is allocated in process.
+  */
+
+  const auto& max_resampled_in = resampler_in->get_max_output_frames(n_samples);
+  const auto& max_resampled_data = max_resampled_in + blocksize;
+
+  resampler_in->reserve(n_samples);
+  resampler_out->reserve(max_resampled_data);
+
+  resampled_in_L.resize(max_resampled_in);
+  resampled_in_R.resize(max_resampled_in);
 
-  resampler_outL = std::make_unique<Resampler>(rnnoise_rate, rate);
-  resampler_outR = std::make_unique<Resampler>(rnnoise_rate, rate);
+  resampled_data_L.reserve(max_resampled_data);
+  resampled_data_R.reserve(max_resampled_data);
+
+  resampled_out_L.resize(resampler_out->get_max_output_frames(max_resampled_data));
+  resampled_out_R.resize(resampler_out->get_max_output_frames(max_resampled_data));
 
   resampler_ready = true;
 }
@@ -100,12 +139,14 @@ void RNNoise::process(std::span<float>& left_in,
                       std::span<float>& right_in,
                       std::span<float>& left_out,
                       std::span<float>& right_out) {
-  std::scoped_lock<std::mutex> lock(data_mutex);
+  std::scoped_lock<std::recursive_mutex> lock(data_mutex);
 
   if (bypass || !rnnoise_ready) {
     std::copy(left_in.begin(), left_in.end(), left_out.begin());
     std::copy(right_in.begin(), right_in.end(), right_out.begin());
 
+    set_vad_gate_closed(false);
+
     return;
   }
 
@@ -115,23 +156,20 @@ void RNNoise::process(std::span<float>& left_in,
 
   if (resample) {
     if (resampler_ready) {
-      const auto& resampled_inL = resampler_inL->process(left_in, false);
-      const auto& resampled_inR = resampler_inR->process(right_in, false);
+      const auto& n_resampled_in = resampler_in->process(left_in, right_in, resampled_in_L, resampled_in_R);
 
       resampled_data_L.resize(0);
       resampled_data_R.resize(0);
 
-      remove_noise(resampled_inL, resampled_inR, resampled_data_L, resampled_data_R);
-
-      auto resampled_outL = resampler_outL->process(resampled_data_L, false);
-      auto resampled_outR = resampler_outR->process(resampled_data_R, false);
+      remove_noise(std::span<const float>(resampled_in_L.data(), n_resampled_in),
+                   std::span<const float>(resampled_in_R.data(), n_resampled_in), resampled_data_L, resampled_data_R);
 
-      for (const auto& v : resampled_outL) {
-        deque_out_L.push_back(v);
-      }
+      const auto& n_resampled_out =
+          resampler_out->process(resampled_data_L, resampled_data_R, resampled_out_L, resampled_out_R);
 
-      for (const auto& v : resampled_outR) {
-        deque_out_R.push_back(v);
+      for (size_t n = 0U; n < n_resampled_out; n++) {
+        deque_out_L.push_back(resampled_out_L[n]);
+        deque_out_R.push_back(resampled_out_R[n]);
       }
     } else {
       for (const auto& v : left_in) {
@@ -215,6 +253,10 @@ void RNNoise::process(std::span<float>& left_in,
     notification_dt += sample_duration;
 
     if (notification_dt >= notification_time_window) {
+      voice_activity_value = vad_probability;
+
+      vad_probability = 0.0F;
+
       notify();
 
       notification_dt = 0.0F;
@@ -222,24 +264,271 @@ void RNNoise::process(std::span<float>& left_in,
   }
 }
 
-auto RNNoise::get_model_from_file() -> RNNModel* {
-  const auto* path = settings->get_string("model-path").c_str();
+void RNNoise::update_channel_mode() {
+  const auto& mode = settings->get_string("channel-mode");
+
+  std::scoped_lock<std::recursive_mutex> lock(data_mutex);
+
+  stop_right_worker();
+
+  if (mode == "Parallel Stereo") {
+    channel_mode = ChannelMode::parallel_stereo;
+
+    start_right_worker();
+  } else if (mode == "Mono") {
+    channel_mode = ChannelMode::mono;
+  } else {
+    channel_mode = ChannelMode::stereo;
+  }
+}
 
-  RNNModel* m = nullptr;
+void RNNoise::start_right_worker() {
+  right_frame_pending = false;
 
-  if (path != nullptr) {
-    FILE* f = fopen(path, "r");
+  right_worker = std::jthread([this](const std::stop_token& stoken) { run_right_worker(stoken); });
 
-    if (f != nullptr) {
-      util::debug("rnnoise plugin: loading model from file: " + std::string(path));
+  /*
+    The realtime thread waits for this one at every frame. So it should not be preempted by normal tasks either. This
+    fails when we are not allowed to use realtime scheduling. The mode still works in this case.
+  */
 
-      m = rnnoise_model_from_file(f);
+  sched_param param{};
 
-      fclose(f);
+  param.sched_priority = sched_get_priority_min(RIGHT_WORKER_SCHEDULER_CLASS);
+
+  if (const auto& ret = pthread_setschedparam(right_worker.native_handle(), RIGHT_WORKER_SCHEDULER_CLASS, &param);
+      ret != 0) {
+    util::warning(log_tag + name + " could not use realtime scheduling for the right channel thread: " +
+                  std::to_string(ret));
+  }
+}
+
+void RNNoise::stop_right_worker() {
+  if (!right_worker.joinable()) {
+    return;
+  }
+
+  right_worker.request_stop();
+
+  // waking up the thread so it can see the stop request
+
+  right_frame_pending = true;
+
+  right_frame_pending.notify_one();
+
+  right_worker.join();
+
+  right_frame_pending = false;
+}
+
+void RNNoise::run_right_worker(const std::stop_token& stoken) {
+  while (true) {
+    right_frame_pending.wait(false);
+
+    if (stoken.stop_requested()) {
+      return;
     }
+
+    right_vad_probability = denoise(state_right, data_R);
+
+    right_frame_pending = false;
+
+    right_frame_pending.notify_one();
   }
+}
 
-  return m;
+auto RNNoise::denoise(DenoiseState* state, std::vector<float>& data) const -> float {
+  if (state == nullptr) {
+    return 0.0F;
+  }
+
+  std::ranges::for_each(data, [](auto& v) { v *= static_cast<float>(SHRT_MAX + 1); });
+
+  const auto& probability = rnnoise_process_frame(state, data.data(), data.data());
+
+  std::ranges::for_each(data, [&](auto& v) { v *= inv_short_max; });
+
+  return probability;
+}
+
+void RNNoise::process_frame() {
+  float probability = 0.0F;
+
+  switch (channel_mode) {
+    case ChannelMode::mono: {
+      for (size_t n = 0U; n < data_L.size(); n++) {
+        data_L[n] = 0.5F * (data_L[n] + data_R[n]);
+      }
+
+      probability = denoise(state_left, data_L);
+
+      std::copy(data_L.begin(), data_L.end(), data_R.begin());
+
+      break;
+    }
+    case ChannelMode::parallel_stereo: {
+      if (right_worker.joinable()) {
+        right_frame_pending = true;
+
+        right_frame_pending.notify_one();
+
+        probability = denoise(state_left, data_L);
+
+        // the frame takes a few tens of microseconds. The helper is usually done by the time the left channel is
+
+        right_frame_pending.wait(true);
+
+        probability = std::max(probability, right_vad_probability);
+
+        break;
+      }
+
+      [[fallthrough]];
+    }
+    case ChannelMode::stereo: {
+      probability = denoise(state_left, data_L);
+
+      probability = std::max(probability, denoise(state_right, data_R));
+
+      break;
+    }
+  }
+
+  update_vad_gate(probability);
+
+  if (vad_gate_muted) {
+    std::ranges::fill(data_L, 0.0F);
+    std::ranges::fill(data_R, 0.0F);
+  }
+}
+
+void RNNoise::set_vad_gated_plugins(const std::vector<PluginBase*>& list) {
+  std::scoped_lock<std::recursive_mutex> lock(data_mutex);
+
+  set_vad_gate_closed(false);
+
+  vad_gated_plugins = list;
+}
+
+void RNNoise::update_vad_settings() {
+  std::scoped_lock<std::recursive_mutex> lock(data_mutex);
+
+  vad_gate = settings->get_boolean("vad-gate");
+
+  vad_threshold = static_cast<float>(settings->get_double("vad-threshold")) / 100.0F;
+
+  // rnnoise frames have 10 ms
+
+  vad_hangover_frames = std::max(1U, static_cast<uint>(std::ceil(settings->get_double("vad-hangover") / 10.0)));
+
+  frames_without_voice = 0U;
+
+  if (!vad_gate) {
+    set_vad_gate_closed(false);
+  }
+}
+
+void RNNoise::update_vad_gate(const float& probability) {
+  vad_probability = std::max(vad_probability, probability);
+
+  if (probability >= vad_threshold) {
+    frames_without_voice = 0U;
+  } else if (frames_without_voice < vad_hangover_frames) {
+    frames_without_voice++;
+  }
+
+  set_vad_gate_closed(vad_gate && frames_without_voice >= vad_hangover_frames);
+}
+
+void RNNoise::set_vad_gate_closed(const bool& state) {
+  if (state == vad_gate_muted) {
+    return;
+  }
+
+  vad_gate_muted = state;
+
+  for (auto* plugin : vad_gated_plugins) {
+    plugin->vad_gate_closed.store(state, std::memory_order_relaxed);
+  }
+}
+
+auto RNNoise::get_model(const std::string& path) -> std::shared_ptr<RNNModel> {
+  if (path.empty()) {
+    return nullptr;
+  }
+
+  std::error_code ec;
+
+  const auto& mtime = std::filesystem::last_write_time(path, ec);
+
+  if (ec) {
+    util::warning("rnnoise plugin: could not access the model file: " + path);
+
+    return nullptr;
+  }
+
+  std::scoped_lock<std::mutex> lock(model_cache_mutex);
+
+  if (const auto& it = model_cache.find(path); it != model_cache.end() && it->second.first == mtime) {
+    if (auto m = it->second.second.lock(); m != nullptr) {
+      util::debug("rnnoise plugin: using the already loaded model: " + path);
+
+      return m;
+    }
+  }
+
+  FILE* f = fopen(path.c_str(), "r");
+
+  if (f == nullptr) {
+    return nullptr;
+  }
+
+  util::debug("rnnoise plugin: loading model from file: " + path);
+
+  auto* m = rnnoise_model_from_file(f);
+
+  fclose(f);
+
+  if (m == nullptr) {
+    return nullptr;
+  }
+
+  std::shared_ptr<RNNModel> shared_model(m, rnnoise_model_free);
+
+  std::erase_if(model_cache, [](const auto& entry) { return entry.second.second.expired(); });
+
+  model_cache[path] = {mtime, shared_model};
+
+  return shared_model;
+}
+
+void RNNoise::load_model(const std::string& path) {
+  auto new_model = get_model(path);
+
+  auto* new_state_left = rnnoise_create(new_model.get());
+  auto* new_state_right = rnnoise_create(new_model.get());
+
+  // only pointers are swapped while the lock is held. The realtime thread never waits for the model creation
+
+  {
+    std::scoped_lock<std::recursive_mutex> lock(data_mutex);
+
+    std::swap(model, new_model);
+    std::swap(state_left, new_state_left);
+    std::swap(state_right, new_state_right);
+
+    rnnoise_ready = true;
+  }
+
+  // after the swap these are the old states
+
+  if (new_state_left != nullptr) {
+    rnnoise_destroy(new_state_left);
+  }
+
+  if (new_state_right != nullptr) {
+    rnnoise_destroy(new_state_right);
+  }
 }
 
 void RNNoise::free_rnnoise() {
@@ -253,11 +542,12 @@ void RNNoise::free_rnnoise() {
     rnnoise_destroy(state_right);
   }
 
-  if (model != nullptr) {
-    rnnoise_model_free(model);
-  }
-
   state_left = nullptr;
   state_right = nullptr;
-  model = nullptr;
+
+  model.reset();
+}
+
+void RNNoise::emit_meters() {
+  voice_activity.emit(voice_activity_value.load());
 }
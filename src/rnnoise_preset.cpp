@@ -35,6 +35,14 @@ void RNNoisePreset::save(nlohmann::json& json,
   json[section]["rnnoise"]["output-gain"] = settings->get_double("output-gain");
 
   json[section]["rnnoise"]["model-path"] = settings->get_string("model-path").c_str();
+
+  json[section]["rnnoise"]["channel-mode"] = settings->get_string("channel-mode").c_str();
+
+  json[section]["rnnoise"]["vad-gate"] = settings->get_boolean("vad-gate");
+
+  json[section]["rnnoise"]["vad-threshold"] = settings->get_double("vad-threshold");
+
+  json[section]["rnnoise"]["vad-hangover"] = settings->get_double("vad-hangover");
 }
 
 void RNNoisePreset::load(const nlohmann::json& json,
@@ -45,4 +53,12 @@ void RNNoisePreset::load(const nlohmann::json& json,
   update_key<double>(json.at(section).at("rnnoise"), settings, "output-gain", "output-gain");
 
   update_string_key(json.at(section).at("rnnoise"), settings, "model-path", "model-path");
+
+  update_string_key(json.at(section).at("rnnoise"), settings, "channel-mode", "channel-mode");
+
+  update_key<bool>(json.at(section).at("rnnoise"), settings, "vad-gate", "vad-gate");
+
+  update_key<double>(json.at(section).at("rnnoise"), settings, "vad-threshold", "vad-threshold");
+
+  update_key<double>(json.at(section).at("rnnoise"), settings, "vad-hangover", "vad-hangover");
 }
@@ -19,6 +19,38 @@
 
 #include "rnnoise_ui.hpp"
 
+namespace {
+
+auto channel_mode_enum_to_int(GValue* value, GVariant* variant, gpointer user_data) -> gboolean {
+  const auto* v = g_variant_get_string(variant, nullptr);
+
+  if (g_strcmp0(v, "Stereo") == 0) {
+    g_value_set_int(value, 0);
+  } else if (g_strcmp0(v, "Parallel Stereo") == 0) {
+    g_value_set_int(value, 1);
+  } else if (g_strcmp0(v, "Mono") == 0) {
+    g_value_set_int(value, 2);
+  }
+
+  return 1;
+}
+
+auto int_to_channel_mode_enum(const GValue* value, const GVariantType* expected_type, gpointer user_data)
+    -> GVariant* {
+  switch (g_value_get_int(value)) {
+    case 1:
+      return g_variant_new_string("Parallel Stereo");
+
+    case 2:
+      return g_variant_new_string("Mono");
+
+    default:
+      return g_variant_new_string("Stereo");
+  }
+}
+
+}  // namespace
+
 RNNoiseUi::RNNoiseUi(BaseObjectType* cobject,
                      const Glib::RefPtr<Gtk::Builder>& builder,
                      const std::string& schema,
@@ -40,6 +72,15 @@ RNNoiseUi::RNNoiseUi(BaseObjectType* cobject,
 
   active_model_name = builder->get_widget<Gtk::Label>("active_model_name");
 
+  channel_mode = builder->get_widget<Gtk::ComboBoxText>("channel_mode");
+
+  voice_activity = builder->get_widget<Gtk::LevelBar>("voice_activity");
+  voice_activity_label = builder->get_widget<Gtk::Label>("voice_activity_label");
+
+  vad_gate = builder->get_widget<Gtk::ToggleButton>("vad_gate");
+  vad_threshold = builder->get_widget<Gtk::SpinButton>("vad_threshold");
+  vad_hangover = builder->get_widget<Gtk::SpinButton>("vad_hangover");
+
   // signals connection
 
   import_model->signal_clicked().connect(sigc::mem_fun(*this, &RNNoiseUi::on_import_model_clicked));
@@ -49,6 +90,17 @@ RNNoiseUi::RNNoiseUi(BaseObjectType* cobject,
   connections.push_back(
       settings->signal_changed("model-path").connect([=, this](const auto& key) { set_active_model_label(); }));
 
+  g_settings_bind_with_mapping(settings->gobj(), "channel-mode", channel_mode->gobj(), "active",
+                               G_SETTINGS_BIND_DEFAULT, channel_mode_enum_to_int, int_to_channel_mode_enum, nullptr,
+                               nullptr);
+
+  settings->bind("vad-gate", vad_gate, "active");
+  settings->bind("vad-threshold", vad_threshold->get_adjustment().get(), "value");
+  settings->bind("vad-hangover", vad_hangover->get_adjustment().get(), "value");
+
+  prepare_spinbutton(vad_threshold, "%");
+  prepare_spinbutton(vad_hangover, "ms");
+
   // model dir
 
   if (!std::filesystem::is_directory(model_dir)) {
@@ -328,4 +380,18 @@ void RNNoiseUi::reset() {
   settings->reset("output-gain");
 
   settings->reset("model-path");
+
+  settings->reset("channel-mode");
+
+  settings->reset("vad-gate");
+
+  settings->reset("vad-threshold");
+
+  settings->reset("vad-hangover");
+}
+
+void RNNoiseUi::on_new_voice_activity(const float& value) {
+  voice_activity->set_value(value);
+
+  voice_activity_label->set_text(level_to_localized_string(100.0F * value, 0));
 }
@@ -16,9 +16,25 @@
  *  You should have received a copy of the GNU General Public License
  *  along with EasyEffects.  If not, see <https://www.gnu.org/licenses/>.
  */
-
 #include "spectrum.hpp"
 
+namespace {
+
+// https://en.wikipedia.org/wiki/Hann_function
+
+auto hann_window(const uint& size) -> std::vector<float> {
+  std::vector<float> output(size);
+
+  for (uint n = 0U; n < size; n++) {
+    output[n] = 0.5F * (1.0F - std::cos(2.0F * std::numbers::pi_v<float> * static_cast<float>(n) /
+                                        static_cast<float>(size - 1U)));
+  }
+
+  return output;
+}
+
+}  // namespace
+
 Spectrum::Spectrum(const std::string& tag,
                    const std::string& schema,
                    const std::string& schema_path,
@@ -27,11 +43,51 @@ Spectrum::Spectrum(const std::string& tag,
   real_input.resize(n_bands);
   output.resize(n_bands / 2U + 1U);
 
+  frame.resize(n_bands);
+  hop.resize(hop_size);
+
+  window = hann_window(n_bands);
+
+  ring.resize(4U * n_bands);
+
   complex_output = fftwf_alloc_complex(n_bands);
 
   plan = fftwf_plan_dft_r2c_1d(static_cast<int>(n_bands), real_input.data(), complex_output, FFTW_ESTIMATE);
 
+  // multiresolution mode
+
+  octave_window = hann_window(octave_fft_size);
+
+  octave_real_input.resize(octave_fft_size);
+
+  octave_complex_output = fftwf_alloc_complex(octave_fft_size);
+
+  octave_plan = fftwf_plan_dft_r2c_1d(static_cast<int>(octave_fft_size), octave_real_input.data(),
+                                      octave_complex_output, FFTW_ESTIMATE);
+
+  /*
+    The kernel only depends on the frequencies as a fraction of the rate. The passband goes up to 0.2 of the rate,
+    where the bins used from the next octave end. Everything above 0.3 of the rate is removed so nothing aliases below
+    0.2 after decimating.
+  */
+
+  anti_aliasing_kernel = FirFilterBase::create_lowpass_kernel(1000U, 250.0F, 100.0F);
+
+  for (auto& octave : octaves) {
+    octave.samples.resize(octave_fft_size);
+    octave.fir_history.resize(2U * anti_aliasing_kernel.size());
+    octave.power.resize(octave_fft_size / 2U + 1U);
+  }
+
+  multiresolution = settings->get_boolean("multiresolution");
+
+  settings->signal_changed("multiresolution").connect([=, this](const auto& key) {
+    multiresolution = settings->get_boolean(key);
+  });
+
   fftw_ready = true;
+
+  worker = std::jthread([this](const std::stop_token& stoken) { run_analysis(stoken); });
 }
 
 Spectrum::~Spectrum() {
@@ -39,27 +95,40 @@ Spectrum::~Spectrum() {
     disconnect_from_pw();
   }
 
-  std::scoped_lock<std::mutex> lock(data_mutex);
+  worker.request_stop();
+
+  if (worker.joinable()) {
+    worker.join();
+  }
+
+  std::scoped_lock<std::recursive_mutex> lock(data_mutex);
 
   fftw_ready = false;
 
   fftwf_destroy_plan(plan);
+  fftwf_destroy_plan(octave_plan);
 
   if (complex_output != nullptr) {
     fftwf_free(complex_output);
   }
 
+  if (octave_complex_output != nullptr) {
+    fftwf_free(octave_complex_output);
+  }
+
   util::debug(log_tag + name + " destroyed");
 }
 
-void Spectrum::setup() {}
+void Spectrum::setup() {
+  // the worker can not read the rate member. It is written by the PipeWire thread
+
+  worker_rate.store(rate, std::memory_order_relaxed);
+}
 
 void Spectrum::process(std::span<float>& left_in,
                        std::span<float>& right_in,
                        std::span<float>& left_out,
                        std::span<float>& right_out) {
-  std::scoped_lock<std::mutex> lock(data_mutex);
-
   std::copy(left_in.begin(), left_in.end(), left_out.begin());
   std::copy(right_in.begin(), right_in.end(), right_out.begin());
 
@@ -67,38 +136,250 @@ void Spectrum::process(std::span<float>& left_in,
     return;
   }
 
-  uint count = 0U;
+  // the downmix is done in small chunks on the stack so nothing is allocated here
 
-  for (uint n = 0U; n < left_in.size(); n++, count++) {
-    if (const uint& k = total_count + n; k < real_input.size()) {
-      // https://en.wikipedia.org/wiki/Hann_function
+  std::array<float, 512U> mono{};
 
-      const float w = 0.5F * (1.0F - std::cos(2.0F * std::numbers::pi_v<float> * static_cast<float>(k) /
-                                              static_cast<float>(real_input.size() - 1U)));
+  for (size_t offset = 0U; offset < left_in.size(); offset += mono.size()) {
+    const auto count = std::min(mono.size(), left_in.size() - offset);
 
-      real_input[k] = 0.5F * (left_in[n] + right_in[n]) * w;
+    for (size_t n = 0U; n < count; n++) {
+      mono[n] = 0.5F * (left_in[offset + n] + right_in[offset + n]);
+    }
+
+    ring.push(std::span{mono.data(), count});
+  }
+}
+
+void Spectrum::run_analysis(const std::stop_token& stoken) {
+  while (!stoken.stop_requested()) {
+    const uint current_rate = worker_rate.load(std::memory_order_relaxed);
+
+    if (const bool& mode = multiresolution.load(); mode != multiresolution_active || current_rate != analysis_rate) {
+      multiresolution_active = mode;
+
+      analysis_rate = current_rate;
+
+      reset_analysis();
+    }
+
+    while (ring.read_available() >= hop_size) {
+      if (multiresolution_active) {
+        ring.pop(hop);
+
+        for (const auto& v : hop) {
+          push_octave_sample(0U, v);
+        }
+      } else {
+        // sliding the analysis window by one hop
+
+        std::copy(frame.begin() + hop_size, frame.end(), frame.begin());
+
+        ring.pop(std::span{frame.data() + n_bands - hop_size, hop_size});
+
+        analyze_frame();
+      }
+
+      publish_frame();
+    }
+
+    // waking up twice per hop is enough to keep up with the realtime thread
+
+    if (current_rate != 0U) {
+      std::this_thread::sleep_for(std::chrono::microseconds(500000U * hop_size / current_rate));
     } else {
-      break;
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
     }
   }
+}
+
+void Spectrum::reset_analysis() {
+  std::ranges::fill(frame, 0.0F);
+  std::ranges::fill(output, 0.0F);
+
+  for (auto& octave : octaves) {
+    octave.position = 0U;
+    octave.new_samples = 0U;
+    octave.fir_position = 0U;
+    octave.decimation_phase = false;
+
+    std::ranges::fill(octave.samples, 0.0F);
+    std::ranges::fill(octave.fir_history, 0.0F);
+    std::ranges::fill(octave.power, 0.0F);
+  }
+
+  // the frequency axis only changes with the mode and the rate
 
-  total_count += count;
+  auto& frequencies = analysis_frequencies;
 
-  if (total_count == real_input.size()) {
-    total_count = 0U;
+  frequencies.resize(0);
 
-    fftwf_execute(plan);
+  if (!multiresolution_active) {
+    frequencies.resize(output.size());
 
     for (uint i = 0U; i < output.size(); i++) {
-      float sqr = complex_output[i][0] * complex_output[i][0] + complex_output[i][1] * complex_output[i][1];
+      frequencies[i] = static_cast<float>(analysis_rate) * static_cast<float>(i) / static_cast<float>(n_bands);
+    }
+  } else {
+    const auto& min_bin = static_cast<uint>(std::ceil(0.2F * static_cast<float>(octave_fft_size)));
+    const auto& max_bin = static_cast<uint>(std::ceil(0.4F * static_cast<float>(octave_fft_size)));
+
+    for (uint k = n_octaves; k-- > 0U;) {
+      const float octave_rate = static_cast<float>(analysis_rate) / static_cast<float>(1U << k);
 
-      sqr /= static_cast<float>(n_samples * n_samples);
+      const uint first = (k == n_octaves - 1U) ? 0U : min_bin;
+      const uint last = (k == 0U) ? octave_fft_size / 2U + 1U : max_bin;
 
-      output[i] = sqr;
+      for (uint i = first; i < last; i++) {
+        frequencies.push_back(octave_rate * static_cast<float>(i) / static_cast<float>(octave_fft_size));
+      }
     }
+  }
+}
+
+void Spectrum::analyze_frame() {
+  for (uint n = 0U; n < n_bands; n++) {
+    real_input[n] = frame[n] * window[n];
+  }
+
+  fftwf_execute(plan);
+
+  const auto& norm = static_cast<float>(n_samples * n_samples);
 
-    auto output_copy = output;
+  for (uint i = 0U; i < output.size(); i++) {
+    float sqr = complex_output[i][0] * complex_output[i][0] + complex_output[i][1] * complex_output[i][1];
 
-    Glib::signal_idle().connect_once([=, this] { power.emit(rate, output_copy.size(), output_copy); });
+    sqr /= norm;
+
+    // exponential average of the overlapping frames
+
+    output[i] = smoothing * output[i] + (1.0F - smoothing) * sqr;
+  }
+}
+
+void Spectrum::push_octave_sample(const uint& k, const float& value) {
+  auto& octave = octaves[k];
+
+  octave.samples[octave.position] = value;
+
+  octave.position = (octave.position + 1U) % octave_fft_size;
+
+  if (++octave.new_samples == octave_hop_size) {
+    octave.new_samples = 0U;
+
+    analyze_octave(k);
+  }
+
+  if (k + 1U == n_octaves) {
+    return;
+  }
+
+  // anti-aliasing filter followed by the decimation by 2
+
+  const auto& taps = static_cast<uint>(anti_aliasing_kernel.size());
+
+  octave.fir_history[octave.fir_position] = value;
+  octave.fir_history[octave.fir_position + taps] = value;
+
+  octave.fir_position = (octave.fir_position + 1U) % taps;
+
+  octave.decimation_phase = !octave.decimation_phase;
+
+  if (!octave.decimation_phase) {
+    return;
+  }
+
+  // the kernel is symmetric. The order the history is read in does not matter
+
+  const float* history = octave.fir_history.data() + octave.fir_position;
+
+  float y = 0.0F;
+
+  for (uint i = 0U; i < taps; i++) {
+    y += anti_aliasing_kernel[i] * history[i];
+  }
+
+  push_octave_sample(k + 1U, y);
+}
+
+void Spectrum::analyze_octave(const uint& k) {
+  auto& octave = octaves[k];
+
+  // the oldest sample is at the current position of the circular buffer
+
+  for (uint n = 0U; n < octave_fft_size; n++) {
+    octave_real_input[n] = octave.samples[(octave.position + n) % octave_fft_size] * octave_window[n];
   }
+
+  fftwf_execute(octave_plan);
+
+  /*
+    Besides the normalization used in the linear mode the power is scaled by the squared ratio between the fft sizes.
+    This way a tone has the same level in both modes.
+  */
+
+  const float size_ratio = static_cast<float>(n_bands) / static_cast<float>(octave_fft_size);
+
+  const auto& norm = static_cast<float>(n_samples * n_samples) / (size_ratio * size_ratio);
+
+  for (uint i = 0U; i < octave.power.size(); i++) {
+    const auto& re = octave_complex_output[i][0];
+    const auto& im = octave_complex_output[i][1];
+
+    float sqr = re * re + im * im;
+
+    sqr /= norm;
+
+    octave.power[i] = smoothing * octave.power[i] + (1.0F - smoothing) * sqr;
+  }
+}
+
+void Spectrum::publish_frame() {
+  auto& back = frames[back_index];
+
+  // only the back buffer belongs to this thread. The others may be in use by the main thread
+
+  back.rate = analysis_rate;
+
+  back.frequencies = analysis_frequencies;
+
+  back.magnitudes.resize(analysis_frequencies.size());
+
+  if (!multiresolution_active) {
+    std::ranges::copy(output, back.magnitudes.begin());
+  } else {
+    // the octaves are concatenated in the same order used to build the frequency axis
+
+    const auto& min_bin = static_cast<uint>(std::ceil(0.2F * static_cast<float>(octave_fft_size)));
+    const auto& max_bin = static_cast<uint>(std::ceil(0.4F * static_cast<float>(octave_fft_size)));
+
+    auto it = back.magnitudes.begin();
+
+    for (uint k = n_octaves; k-- > 0U;) {
+      const uint first = (k == n_octaves - 1U) ? 0U : min_bin;
+      const uint last = (k == 0U) ? octave_fft_size / 2U + 1U : max_bin;
+
+      it = std::copy(octaves[k].power.begin() + first, octaves[k].power.begin() + last, it);
+    }
+  }
+
+  back_index = middle_index.exchange(back_index | new_frame_flag) & ~new_frame_flag;
+
+  // a single pending idle source is enough. It always shows the newest frame
+
+  if (idle_pending.exchange(true)) {
+    return;
+  }
+
+  Glib::signal_idle().connect_once([this] {
+    idle_pending = false;
+
+    if ((middle_index.load() & new_frame_flag) != 0U) {
+      front_index = middle_index.exchange(front_index) & ~new_frame_flag;
+    }
+
+    const auto& front = frames[front_index];
+
+    power.emit(front.rate, front.frequencies, front.magnitudes);
+  });
 }
@@ -28,6 +28,8 @@ auto spectrum_type_enum_to_int(GValue* value, GVariant* variant, gpointer user_d
     g_value_set_int(value, 0);
   } else if (g_strcmp0(v, "Lines") == 0) {
     g_value_set_int(value, 1);
+  } else if (g_strcmp0(v, "Spectrogram") == 0) {
+    g_value_set_int(value, 2);
   }
 
   return 1;
@@ -42,6 +44,9 @@ auto int_to_spectrum_type_enum(const GValue* value, const GVariantType* expected
     case 1:
       return g_variant_new_string("Lines");
 
+    case 2:
+      return g_variant_new_string("Spectrogram");
+
     default:
       return g_variant_new_string("Bars");
   }
@@ -58,6 +63,7 @@ SpectrumSettingsUi::SpectrumSettingsUi(BaseObjectType* cobject,
   show = builder->get_widget<Gtk::Switch>("show");
   fill = builder->get_widget<Gtk::Switch>("fill");
   show_bar_border = builder->get_widget<Gtk::Switch>("show_bar_border");
+  multiresolution = builder->get_widget<Gtk::Switch>("multiresolution");
 
   spectrum_color_button = builder->get_widget<Gtk::ColorButton>("spectrum_color_button");
   axis_color_button = builder->get_widget<Gtk::ColorButton>("axis_color_button");
@@ -163,6 +169,7 @@ SpectrumSettingsUi::SpectrumSettingsUi(BaseObjectType* cobject,
   settings->bind("show", show, "active");
   settings->bind("fill", fill, "active");
   settings->bind("show-bar-border", show_bar_border, "active");
+  settings->bind("multiresolution", multiresolution, "active");
   settings->bind("n-points", n_points->get_adjustment().get(), "value");
   settings->bind("height", height->get_adjustment().get(), "value");
   settings->bind("line-width", line_width->get_adjustment().get(), "value");
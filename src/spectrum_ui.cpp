@@ -93,70 +93,43 @@ auto SpectrumUi::add_to_box(Gtk::Box* box) -> SpectrumUi* {
   return ui;
 }
 
-void SpectrumUi::on_new_spectrum(uint rate, uint n_bands, std::vector<float> magnitudes) {
+void SpectrumUi::on_new_spectrum(uint rate,
+                                 const std::vector<float>& frequencies,
+                                 const std::vector<float>& magnitudes) {
   if (!settings->get_boolean("show")) {
     return;
   }
 
-  if (this->rate != rate || this->n_bands != n_bands) {
+  // the bins frequencies only change with the rate and the analyzer mode
+
+  if (this->rate != rate || spectrum_freqs != frequencies) {
     this->rate = rate;
-    this->n_bands = n_bands;
+
+    spectrum_freqs = frequencies;
 
     init_frequency_axis();
   }
 
-  std::ranges::fill(spectrum_mag, 0.0F);
-  std::ranges::fill(spectrum_bin_count, 0U);
-
-  // reducing the amount of data so we can plot them
-
-  for (size_t j = 0U; j < spectrum_freqs.size(); j++) {
-    for (size_t n = 0U; n < spectrum_x_axis.size(); n++) {
-      if (n > 0U) {
-        if (spectrum_freqs[j] <= spectrum_x_axis[n] && spectrum_freqs[j] > spectrum_x_axis[n - 1U]) {
-          spectrum_mag[n] += magnitudes[j];
-
-          spectrum_bin_count[n]++;
-        }
-      } else {
-        if (spectrum_freqs[j] <= spectrum_x_axis[n]) {
-          spectrum_mag[n] += magnitudes[j];
-
-          spectrum_bin_count[n]++;
-        }
-      }
-    }
+  if (spectrum_point_bins.empty() || magnitudes.size() < spectrum_freqs.size()) {
+    return;
   }
 
-  for (size_t n = 0U; n < spectrum_bin_count.size(); n++) {
-    if (spectrum_bin_count[n] == 0U && n > 0U) {
-      spectrum_mag[n] = spectrum_mag[n - 1U];
+  // reducing the amount of data so we can plot them. Each point is summed and converted to decibel in a single pass
 
-      // doing a very poor interpolation for the bins without any count
+  for (size_t n = 0U; n < spectrum_point_bins.size(); n++) {
+    const auto& p = spectrum_point_bins[n];
 
-      // int count = 1;
+    float v = 0.0F;
 
-      // while (count + n < spectrum_bin_count.size()) {
-      //   if (spectrum_bin_count[count + n] != 0) {
-      //     break;
-      //   }
-
-      //   count++;
-      // }
-
-      // float last_mag = spectrum_mag[n + count];
-
-      // float delta = (last_mag - spectrum_mag[n - 1]) / static_cast<float>(count);
-
-      // for (int k = 0; k < count; k++) {
-      //   spectrum_mag[n + k] = spectrum_mag[n - 1] + k * delta;
-
-      //   spectrum_bin_count[n + k] = 1;
-      // }
+    if (p.end > p.start) {
+      for (uint j = p.start; j < p.end; j++) {
+        v += magnitudes[j];
+      }
+    } else {
+      v = (1.0F - p.interpolation_weight) * magnitudes[p.interpolation_bin] +
+          p.interpolation_weight * magnitudes[p.interpolation_bin + 1U];
     }
-  }
 
-  std::ranges::for_each(spectrum_mag, [](auto& v) {
     v = 10.0F * std::log10(v);
 
     if (!std::isinf(v)) {
@@ -164,7 +137,9 @@ void SpectrumUi::on_new_spectrum(uint rate, uint n_bands, std::vector<float> mag
     } else {
       v = util::minimum_db_level;
     }
-  });
+
+    spectrum_mag[n] = v;
+  }
 
   plot->set_data(spectrum_x_axis, spectrum_mag);
 }
@@ -184,31 +159,71 @@ void SpectrumUi::init_type() {
     plot->set_plot_type(PlotType::bar);
   } else if (settings->get_string("type") == "Lines") {
     plot->set_plot_type(PlotType::line);
+  } else if (settings->get_string("type") == "Spectrogram") {
+    plot->set_plot_type(PlotType::spectrogram);
   }
 }
 
 void SpectrumUi::init_frequency_axis() {
-  spectrum_freqs.resize(n_bands);
+  spectrum_point_bins.resize(0);
+
+  const auto& n_bins = static_cast<uint>(spectrum_freqs.size());
 
-  for (uint n = 0U; n < n_bands; n++) {
-    spectrum_freqs[n] = 0.5F * rate * static_cast<float>(n) / static_cast<float>(n_bands);
+  if (n_bins < 2U || rate == 0U) {
+    return;
   }
 
-  if (!spectrum_freqs.empty()) {
-    const auto min_freq = static_cast<float>(settings->get_int("minimum-frequency"));
-    const auto max_freq = static_cast<float>(settings->get_int("maximum-frequency"));
+  const auto min_freq = static_cast<float>(settings->get_int("minimum-frequency"));
+  const auto max_freq = static_cast<float>(settings->get_int("maximum-frequency"));
+
+  if (min_freq > (max_freq - 100.0F)) {
+    return;
+  }
+
+  spectrum_x_axis = util::logspace(std::log10(min_freq), std::log10(max_freq), settings->get_int("n-points"));
+
+  const auto& x_axis_size = spectrum_x_axis.size();
+
+  spectrum_mag.resize(x_axis_size);
 
-    if (min_freq > (max_freq - 100.0F)) {
-      return;
+  spectrum_point_bins.resize(x_axis_size);
+
+  /*
+    Both the bins and the points are sorted by frequency. So each point gets a contiguous range of bins and the whole
+    map is built walking the bins only once. The first point also gets the bins below the minimum frequency. The bins
+    do not have to be uniformly spaced. The multiresolution analyzer mode has a different spacing in each octave.
+  */
+
+  uint j = 0U;
+
+  for (size_t n = 0U; n < x_axis_size; n++) {
+    auto& p = spectrum_point_bins[n];
+
+    p.start = j;
+
+    while (j < n_bins && spectrum_freqs[j] <= spectrum_x_axis[n]) {
+      j++;
     }
 
-    spectrum_x_axis = util::logspace(std::log10(min_freq), std::log10(max_freq), settings->get_int("n-points"));
+    p.end = j;
 
-    const auto& x_axis_size = spectrum_x_axis.size();
+    if (p.end != p.start) {
+      continue;
+    }
 
-    spectrum_mag.resize(x_axis_size);
+    // j is the first bin above the point frequency
 
-    spectrum_bin_count.resize(x_axis_size);
+    if (j == 0U) {
+      p.interpolation_bin = 0U;
+      p.interpolation_weight = 0.0F;
+    } else if (j == n_bins) {
+      p.interpolation_bin = n_bins - 2U;
+      p.interpolation_weight = 1.0F;
+    } else {
+      p.interpolation_bin = j - 1U;
+      p.interpolation_weight =
+          (spectrum_x_axis[n] - spectrum_freqs[j - 1U]) / (spectrum_freqs[j] - spectrum_freqs[j - 1U]);
+    }
   }
 }
 
@@ -113,11 +113,17 @@ void StereoTools::process(std::span<float>& left_in,
 
       correlation_port_value = static_cast<double>(lv2_wrapper->get_control_port_value("meter_phase"));
 
-      Glib::signal_idle().connect_once([=, this] { new_correlation.emit(correlation_port_value); });
-
       notify();
 
       notification_dt = 0.0F;
     }
   }
 }
+
+void StereoTools::emit_meters() {
+  new_correlation.emit(correlation_port_value.load());
+}
+
+auto StereoTools::set_realtime_parameter(const std::string& key, const Glib::VariantBase& value) -> bool {
+  return PluginBase::set_realtime_parameter(key, value) || lv2_wrapper->set_bound_key(settings, key, value);
+}
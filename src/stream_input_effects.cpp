@@ -205,6 +205,24 @@ void StreamInputEffects::connect_filters(const bool& bypass) {
     }
   }
 
+  // the plugins after rnnoise are not processed while its voice activity gate is closed
+
+  std::vector<PluginBase*> vad_gated_plugins;
+
+  auto after_rnnoise = false;
+
+  for (const auto& name : list) {
+    if (after_rnnoise) {
+      vad_gated_plugins.push_back(plugins[name].get());
+    }
+
+    if (name == plugin_name::rnnoise) {
+      after_rnnoise = true;
+    }
+  }
+
+  rnnoise->set_vad_gated_plugins(vad_gated_plugins);
+
   // link spectrum, output level meter and source node
 
   for (const auto& node_id : {spectrum->get_node_id(), output_level->get_node_id(), pm->ee_source_node.id}) {
@@ -229,6 +247,8 @@ void StreamInputEffects::connect_filters(const bool& bypass) {
 }
 
 void StreamInputEffects::disconnect_filters() {
+  rnnoise->set_vad_gated_plugins({});
+
   std::set<uint> list;
 
   for (const auto& plugin : plugins | std::views::values) {